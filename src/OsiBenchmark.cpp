@@ -0,0 +1,484 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+/** Benchmark of the matching, on synthetic templates (see OsiCodeGenerator).
+*
+* Usage : OsiBenchmark [option value]...
+* - --modes : modes to run, among verify, identify, all-vs-all (default verify,identify,all-vs-all)
+* - --pairs : number of genuine and of impostor pairs for verify (default 20000)
+* - --sizes : gallery sizes for identify (default 1000,10000,100000, up to millions if memory allows)
+* - --queries : number of probes searched in each gallery (default 32)
+* - --matrix : numbers of templates for all-vs-all (default 1000,4000)
+* - --threads : numbers of threads (default 1,2,4... up to the number of cores)
+* - --kernel : kernel counting the bits, see OsiHamming (default auto)
+* - --seed : seed of the generator (default 1)
+* - --points : textfile of application points, as data/OsirisParam/points.txt (default : the grid of this file)
+* - --output : file for the results (default standard output)
+*
+* The results are written in JSON, the progress on the standard error.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "OsiCodeGenerator.h"
+#include "OsiGallery.h"
+#include "OsiHamming.h"
+#include "OsiIrisCode.h"
+#include "OsiScoreMatrix.h"
+
+using namespace std ;
+using namespace osiris ;
+
+// Decision threshold used to count the accepted pairs
+static const float THRESHOLD = 0.32f ;
+
+
+
+// Time in seconds
+static double getTime ( )
+{
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count() ;
+}
+
+
+
+// Split a list of values separated by commas
+static vector<string> splitList ( const string & rList )
+{
+    vector<string> values ;
+    stringstream stream(rList) ;
+    string value ;
+    while ( getline(stream,value,',') )
+    {
+        if ( ! value.empty() )
+        {
+            values.push_back(value) ;
+        }
+    }
+    return values ;
+}
+
+
+
+static vector<int> splitIntegers ( const string & rList )
+{
+    vector<string> values = splitList(rList) ;
+    vector<int> integers ;
+    for ( int i = 0 ; i < values.size() ; i++ )
+    {
+        int value = atoi(values[i].c_str()) ;
+        if ( value <= 0 )
+        {
+            throw runtime_error("Invalid value in the list " + rList) ;
+        }
+        integers.push_back(value) ;
+    }
+    return integers ;
+}
+
+
+
+// Time one matching function on genuine or impostor pairs
+static string benchmarkPairs ( const vector<OsiIrisCode> & rCodes1 , const vector<OsiIrisCode> & rCodes2 ,
+                               const string & rFunction , const string & rPairs )
+{
+    int n_pairs = rCodes1.size() ;
+    double sum = 0 ;
+    int accepted = 0 ;
+    double start = getTime() ;
+    for ( int i = 0 ; i < n_pairs ; i++ )
+    {
+        float score ;
+        bool accept ;
+        if ( rFunction == "match" )
+        {
+            score = rCodes1[i].match(rCodes2[i]) ;
+            accept = ( score < THRESHOLD ) ;
+        }
+        else
+        {
+            accept = rCodes1[i].verify(rCodes2[i],THRESHOLD,score) ;
+        }
+        sum += score ;
+        accepted += accept ;
+    }
+    double seconds = getTime() - start ;
+
+    ostringstream result ;
+    result << "{ \"mode\" : \"verify\" , \"function\" : \"" << rFunction << "\" , \"pairs\" : \"" << rPairs << "\" , "
+           << "\"count\" : " << n_pairs << " , \"seconds\" : " << seconds << " , "
+           << "\"matches_per_second\" : " << n_pairs / seconds << " , " ;
+    if ( rFunction == "match" )
+    {
+        // The scores of the rejected pairs are only bounds with verify
+        result << "\"mean_score\" : " << sum / max(n_pairs,1) << " , " ;
+    }
+    result << "\"accepted_rate\" : " << (double)accepted / max(n_pairs,1) << " }" ;
+    return result.str() ;
+}
+
+
+
+// 1:1 matching of genuine and impostor pairs
+static void benchmarkVerify ( const OsiCodeGenerator & rGenerator , int nPairs , vector<string> & rResults )
+{
+    cerr << "Verify : " << nPairs << " genuine and impostor pairs" << endl ;
+    vector<OsiIrisCode> enrolled(nPairs) , genuine(nPairs) , impostor(nPairs) ;
+    for ( int i = 0 ; i < nPairs ; i++ )
+    {
+        rGenerator.createCode(i,enrolled[i]) ;
+        rGenerator.createGenuine(i,0,genuine[i]) ;
+        rGenerator.createCode(i+nPairs,impostor[i]) ;
+    }
+
+    const char * functions [] = { "match" , "verify" } ;
+    for ( int f = 0 ; f < 2 ; f++ )
+    {
+        rResults.push_back(benchmarkPairs(genuine,enrolled,functions[f],"genuine")) ;
+        rResults.push_back(benchmarkPairs(impostor,enrolled,functions[f],"impostor")) ;
+    }
+}
+
+
+
+// Application points of a textfile of OSIRIS (number of points, then row and column of each),
+// packed row by row : the rows holding points are the rows of the templates
+static vector<uint64_t> loadPoints ( const string & rFilename , int width , int & rHeight )
+{
+    ifstream file(rFilename.c_str(),ios::in) ;
+    int n_points = 0 ;
+    if ( ! ( file >> n_points ) || n_points <= 0 )
+    {
+        throw runtime_error("Cannot load the application points in " + rFilename) ;
+    }
+    vector<int> rows(n_points) , cols(n_points) ;
+    set<int> used_rows ;
+    for ( int p = 0 ; p < n_points ; p++ )
+    {
+        if ( ! ( file >> rows[p] >> cols[p] ) || cols[p] < 0 || cols[p] >= width )
+        {
+            throw runtime_error("Invalid application point in " + rFilename) ;
+        }
+        used_rows.insert(rows[p]) ;
+    }
+
+    rHeight = used_rows.size() ;
+    int words = ( width + 63 ) / 64 ;
+    vector<uint64_t> points((size_t)rHeight*words,0) ;
+    for ( int p = 0 ; p < n_points ; p++ )
+    {
+        int r = distance(used_rows.begin(),used_rows.find(rows[p])) ;
+        points[(size_t)r*words+cols[p]/64] |= (uint64_t) 1 << (cols[p]%64) ;
+    }
+    return points ;
+}
+
+
+
+// Identification must not depend on the number of threads, even when scores tie : a gallery
+// of copies of the same template is searched with one thread and with several ones
+static bool checkIdentify ( const OsiCodeGenerator & rGenerator )
+{
+    OsiGallery gallery ;
+    OsiIrisCode code ;
+    rGenerator.createCode(0,code) ;
+    for ( int i = 0 ; i < 8 * OSI_GALLERY_CHUNK ; i++ )
+    {
+        gallery.enroll(to_string((long long)i),code) ;
+    }
+    vector<OsiIrisCode> probes(2) ;
+    rGenerator.createGenuine(0,1,probes[0]) ;
+    rGenerator.createCode(1,probes[1]) ;
+
+    const int n_threads [3] = { 1 , 3 , 8 } ;
+    vector< vector<OsiCandidate> > reference ;
+    for ( int t = 0 ; t < 3 ; t++ )
+    {
+        vector< vector<OsiCandidate> > candidates = gallery.identify(probes,5,n_threads[t]) ;
+        for ( int p = 0 ; p < probes.size() ; p++ )
+        {
+            // Same scores : the entries of lowest indices are kept
+            for ( int k = 0 ; k < candidates[p].size() ; k++ )
+            {
+                if ( candidates[p][k].mIndex != k )
+                {
+                    return false ;
+                }
+            }
+            if ( t && ( candidates[p].size() != reference[p].size() ||
+                        ( ! candidates[p].empty() && candidates[p][0].mScore != reference[p][0].mScore ) ) )
+            {
+                return false ;
+            }
+        }
+        reference = candidates ;
+    }
+    return true ;
+}
+
+
+
+// 1:N search of genuine probes in galleries of several sizes
+static void benchmarkIdentify ( const OsiCodeGenerator & rGenerator , const vector<int> & rSizes , int nQueries ,
+                                const vector<int> & rThreads , vector<string> & rResults )
+{
+    for ( int s = 0 ; s < rSizes.size() ; s++ )
+    {
+        int size = rSizes[s] ;
+        cerr << "Identify : gallery of " << size << " templates" << endl ;
+
+        // Enrollment
+        double start = getTime() ;
+        OsiGallery gallery ;
+        OsiIrisCode code ;
+        for ( int i = 0 ; i < size ; i++ )
+        {
+            rGenerator.createCode(i,code) ;
+            gallery.enroll(to_string((long long)i),code) ;
+        }
+        double enrollment = getTime() - start ;
+
+        // Probes : other captures of identities spread over the gallery
+        vector<OsiIrisCode> probes(nQueries) ;
+        vector<int> identities(nQueries) ;
+        for ( int q = 0 ; q < nQueries ; q++ )
+        {
+            identities[q] = (int)( (int64_t)q * size / nQueries ) ;
+            rGenerator.createGenuine(identities[q],1,probes[q]) ;
+        }
+
+        for ( int t = 0 ; t < rThreads.size() ; t++ )
+        {
+            // One scan per probe, one scan per batch of probes, then coarse to fine by batches
+            const char * methods [3] = { "single" , "batched" , "cascade" } ;
+            for ( int m = 0 ; m < 3 ; m++ )
+            {
+                cerr << "  " << rThreads[t] << " threads, " << methods[m] << endl ;
+                vector< vector<OsiCandidate> > candidates ;
+                start = getTime() ;
+                if ( m == 2 )
+                {
+                    candidates = gallery.identify(probes,5,OsiCascade(),rThreads[t]) ;
+                }
+                else if ( m == 1 )
+                {
+                    candidates = gallery.identify(probes,5,rThreads[t]) ;
+                }
+                else
+                {
+                    for ( int q = 0 ; q < nQueries ; q++ )
+                    {
+                        candidates.push_back(gallery.identify(probes[q],5,rThreads[t])) ;
+                    }
+                }
+                double seconds = getTime() - start ;
+
+                int found = 0 ;
+                for ( int q = 0 ; q < nQueries ; q++ )
+                {
+                    found += ( ! candidates[q].empty() && candidates[q][0].mIndex == identities[q] ) ;
+                }
+
+                ostringstream result ;
+                result << "{ \"mode\" : \"identify\" , \"gallery\" : " << size << " , \"threads\" : " << rThreads[t] << " , "
+                       << "\"method\" : \"" << methods[m] << "\" , \"queries\" : " << nQueries << " , "
+                       << "\"enrollment_seconds\" : " << enrollment << " , \"seconds\" : " << seconds << " , "
+                       << "\"ms_per_query\" : " << 1000 * seconds / nQueries << " , "
+                       << "\"matches_per_second\" : " << (double)size * nQueries / seconds << " , "
+                       << "\"rank1_rate\" : " << (double)found / nQueries << " }" ;
+                rResults.push_back(result.str()) ;
+            }
+        }
+    }
+}
+
+
+
+// N x N matching : two captures of N/2 identities
+static void benchmarkAllVsAll ( const OsiCodeGenerator & rGenerator , const vector<int> & rSizes ,
+                                const vector<int> & rThreads , vector<string> & rResults )
+{
+    for ( int s = 0 ; s < rSizes.size() ; s++ )
+    {
+        int size = rSizes[s] ;
+        cerr << "All-vs-all : " << size << " templates" << endl ;
+        vector<OsiIrisCode> codes(size) ;
+        for ( int i = 0 ; i < size ; i++ )
+        {
+            if ( i % 2 )
+            {
+                rGenerator.createGenuine(i/2,0,codes[i]) ;
+            }
+            else
+            {
+                rGenerator.createCode(i/2,codes[i]) ;
+            }
+        }
+
+        for ( int t = 0 ; t < rThreads.size() ; t++ )
+        {
+            cerr << "  " << rThreads[t] << " threads" << endl ;
+            OsiScoreMatrix matrix ;
+            double start = getTime() ;
+            matrix.compute(codes,rThreads[t]) ;
+            double seconds = getTime() - start ;
+            // The symmetric matrix is computed with its diagonal
+            double n_matches = (double)size * ( size + 1 ) / 2 ;
+
+            ostringstream result ;
+            result << "{ \"mode\" : \"all-vs-all\" , \"templates\" : " << size << " , \"threads\" : " << rThreads[t] << " , "
+                   << "\"matches\" : " << n_matches << " , \"seconds\" : " << seconds << " , "
+                   << "\"matches_per_second\" : " << n_matches / seconds << " }" ;
+            rResults.push_back(result.str()) ;
+        }
+    }
+}
+
+
+
+int main ( int argc , char * argv [] )
+{
+    try
+    {
+        // Default options
+        int n_cores = max((int)thread::hardware_concurrency(),1) ;
+        string threads ;
+        for ( int t = 1 ; t < n_cores ; t *= 2 )
+        {
+            threads += to_string((long long)t) + "," ;
+        }
+        threads += to_string((long long)n_cores) ;
+        string modes = "verify,identify,all-vs-all" ;
+        string sizes = "1000,10000,100000" ;
+        string matrix = "1000,4000" ;
+        string kernel = "auto" ;
+        string output = "" ;
+        string points_file = "" ;
+        int n_pairs = 20000 ;
+        int n_queries = 32 ;
+        uint64_t seed = 1 ;
+
+        // Command line
+        for ( int a = 1 ; a + 1 < argc ; a += 2 )
+        {
+            string option = argv[a] ;
+            string value = argv[a+1] ;
+            if ( option == "--modes" ) modes = value ;
+            else if ( option == "--pairs" ) n_pairs = max(atoi(value.c_str()),1) ;
+            else if ( option == "--sizes" ) sizes = value ;
+            else if ( option == "--queries" ) n_queries = max(atoi(value.c_str()),1) ;
+            else if ( option == "--matrix" ) matrix = value ;
+            else if ( option == "--threads" ) threads = value ;
+            else if ( option == "--kernel" ) kernel = value ;
+            else if ( option == "--seed" ) seed = strtoull(value.c_str(),0,10) ;
+            else if ( option == "--output" ) output = value ;
+            else if ( option == "--points" ) points_file = value ;
+            else throw runtime_error("Unknown option " + option) ;
+        }
+        if ( argc % 2 == 0 )
+        {
+            throw runtime_error("Missing value for option " + string(argv[argc-1])) ;
+        }
+
+        OsiHamming::setKernel(kernel) ;
+        if ( ! OsiHamming::checkKernels() )
+        {
+            throw runtime_error("The kernels counting the different bits of the codes do not give the same results") ;
+        }
+
+        // Templates of the shipped configuration : 8 rows of 512 columns, 6 filters,
+        // or the rows of the application points of the file
+        int height = 8 ;
+        vector<uint64_t> points ;
+        if ( points_file != "" )
+        {
+            points = loadPoints(points_file,512,height) ;
+        }
+        OsiCodeGenerator generator(512,height,6,seed) ;
+        if ( ! points.empty() )
+        {
+            generator.setApplicationPoints(points) ;
+        }
+        OsiIrisCode code ;
+        generator.createCode(0,code) ;
+
+        if ( ! checkIdentify(generator) )
+        {
+            throw runtime_error("The candidates of identification depend on the number of threads") ;
+        }
+
+        vector<string> results ;
+        vector<string> list_of_modes = splitList(modes) ;
+        for ( int m = 0 ; m < list_of_modes.size() ; m++ )
+        {
+            if ( list_of_modes[m] == "verify" )
+            {
+                benchmarkVerify(generator,n_pairs,results) ;
+            }
+            else if ( list_of_modes[m] == "identify" )
+            {
+                benchmarkIdentify(generator,splitIntegers(sizes),n_queries,splitIntegers(threads),results) ;
+            }
+            else if ( list_of_modes[m] == "all-vs-all" )
+            {
+                benchmarkAllVsAll(generator,splitIntegers(matrix),splitIntegers(threads),results) ;
+            }
+            else
+            {
+                throw runtime_error("Unknown mode " + list_of_modes[m]) ;
+            }
+        }
+
+        // Results
+        ostringstream json ;
+        json << "{" << endl ;
+        json << "  \"kernel\" : \"" << OsiHamming::getName(OsiHamming::getKernel()) << "\" ," << endl ;
+        json << "  \"hardware_threads\" : " << n_cores << " ," << endl ;
+        json << "  \"template\" : { \"width\" : " << code.getWidth() << " , \"rows\" : " << code.getHeight()
+             << " , \"filters\" : " << code.getNumberOfFilters() << " , \"bytes\" : " << code.getDataSize() * 8 << " } ," << endl ;
+        json << "  \"seed\" : " << seed << " ," << endl ;
+        json << "  \"results\" : [" << endl ;
+        for ( int r = 0 ; r < results.size() ; r++ )
+        {
+            json << "    " << results[r] << ( r + 1 < results.size() ? " ," : "" ) << endl ;
+        }
+        json << "  ]" << endl ;
+        json << "}" << endl ;
+
+        if ( output != "" )
+        {
+            ofstream file(output.c_str(),ios::out) ;
+            file << json.str() ;
+            if ( ! file )
+            {
+                throw runtime_error("Cannot save the results in " + output) ;
+            }
+        }
+        else
+        {
+            cout << json.str() ;
+        }
+    }
+    catch ( exception & e )
+    {
+        cerr << e.what() << endl ;
+        return 1 ;
+    }
+
+    return 0 ;
+}
+
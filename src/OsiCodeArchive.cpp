@@ -0,0 +1,446 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "OsiCodeArchive.h"
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // Coding of the mask in an entry
+    static const int32_t MASK_WORDS = 0 ;
+    static const int32_t MASK_RUNS = 1 ;
+
+
+
+    // Append a value to a buffer of bytes
+    template<class T> static void appendValue ( vector<char> & rBuffer , const T & rValue )
+    {
+        rBuffer.insert(rBuffer.end(),(const char*)&rValue,(const char*)&rValue+sizeof(T)) ;
+    }
+
+
+
+
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiCodeArchive::OsiCodeArchive ( )
+    {
+        mCompressMasks = true ;
+    }
+
+    OsiCodeArchive::~OsiCodeArchive ( )
+    {
+        try
+        {
+            close() ;
+        }
+        catch ( exception & )
+        {
+            // An error cannot be reported from the destructor
+        }
+    }
+
+
+
+
+
+    // OPERATORS
+    ////////////
+
+    void OsiCodeArchive::create ( const string & rFilename , bool compressMasks )
+    {
+        close() ;
+
+        mOutput.open(rFilename.c_str(),ios::out|ios::binary) ;
+        if ( ! mOutput )
+        {
+            throw runtime_error("Cannot create the archive of iris codes : " + rFilename) ;
+        }
+
+        // The header is written again with the index, an unfinished archive has no index
+        char header[64] ;
+        memset(header,0,sizeof(header)) ;
+        mOutput.write(header,sizeof(header)) ;
+
+        mFilename = rFilename ;
+        mCompressMasks = compressMasks ;
+    }
+
+
+
+    bool OsiCodeArchive::add ( const string & rName , const OsiIrisCode & rCode )
+    {
+        if ( ! mOutput.is_open() )
+        {
+            throw runtime_error("Cannot add " + rName + " because the archive of iris codes is not created") ;
+        }
+        if ( rCode.isEmpty() )
+        {
+            throw runtime_error("Cannot add " + rName + " to the archive because its iris code is not built") ;
+        }
+        if ( mIndexOfNames.count(rName) )
+        {
+            return false ;
+        }
+
+        // The mask as run lengths, if it is smaller than the words
+        size_t n_mask_words = (size_t)rCode.getHeight() * rCode.getNumberOfWords() ;
+        size_t n_code_words = rCode.getDataSize() - n_mask_words ;
+        vector<unsigned char> runs ;
+        if ( mCompressMasks )
+        {
+            encodeMask(rCode,runs) ;
+        }
+        bool use_runs = mCompressMasks && runs.size() < n_mask_words * 8 ;
+
+        // Sizes, rows, code planes and mask
+        vector<char> entry ;
+        appendValue(entry,(int32_t)rCode.getWidth()) ;
+        appendValue(entry,(int32_t)rCode.getHeight()) ;
+        appendValue(entry,(int32_t)rCode.getNumberOfFilters()) ;
+        appendValue(entry,use_runs ? MASK_RUNS : MASK_WORDS) ;
+        appendValue(entry,(int32_t)( use_runs ? runs.size() : n_mask_words * 8 )) ;
+        for ( int r = 0 ; r < rCode.getHeight() ; r++ )
+        {
+            appendValue(entry,(int32_t)rCode.getRowIndex(r)) ;
+        }
+        entry.resize((entry.size()+7)/8*8,0) ;
+        const char * p_data = (const char*)rCode.getData() ;
+        entry.insert(entry.end(),p_data,p_data+n_code_words*8) ;
+        if ( use_runs )
+        {
+            entry.insert(entry.end(),runs.begin(),runs.end()) ;
+        }
+        else
+        {
+            entry.insert(entry.end(),p_data+n_code_words*8,p_data+rCode.getDataSize()*8) ;
+        }
+
+        // Entries are aligned on 8 bytes
+        mOffsets.push_back(mOutput.tellp()) ;
+        mSizes.push_back(entry.size()) ;
+        mChecksums.push_back(OsiMappedFile::computeChecksum(&entry[0],entry.size())) ;
+        entry.resize((entry.size()+7)/8*8,0) ;
+        mOutput.write(&entry[0],entry.size()) ;
+        if ( ! mOutput )
+        {
+            throw runtime_error("Error while saving iris codes in " + mFilename) ;
+        }
+
+        mIndexOfNames[rName] = mNames.size() ;
+        mNames.push_back(rName) ;
+
+        return true ;
+    }
+
+
+
+    void OsiCodeArchive::open ( const string & rFilename )
+    {
+        close() ;
+        mInput.open(rFilename) ;
+        mFilename = rFilename ;
+
+        const char * p_data = mInput.getData() ;
+        size_t size = mInput.getSize() ;
+
+        // Header
+        int32_t values[4] = { 0 , 0 , 0 , 0 } ;
+        int64_t index_offset = 0 ;
+        if ( size >= 64 && ! memcmp(p_data,"OSIA",4) )
+        {
+            memcpy(values,p_data,sizeof(values)) ;
+            memcpy(&index_offset,p_data+16,8) ;
+        }
+        int n_entries = values[2] ;
+        uint32_t index_checksum = values[3] ;
+
+        // The index must fit in the file, and be intact
+        bool valid = ( size >= 64 && values[1] == 1 && n_entries >= 0 &&
+                       index_offset >= 64 && index_offset % 8 == 0 &&
+                       (uint64_t)index_offset + 8 <= size && ( size - index_offset - 8 ) / 24 >= (uint64_t)n_entries &&
+                       OsiMappedFile::computeChecksum(p_data+index_offset,size-index_offset) == index_checksum ) ;
+        if ( valid )
+        {
+            const char * p_index = p_data + index_offset ;
+            const char * p_names = p_index + 24 * (size_t)n_entries + 8 ;
+            uint64_t names_size = size - ( p_names - p_data ) ;
+            mOffsets.resize(n_entries) ;
+            mSizes.resize(n_entries) ;
+            mChecksums.resize(n_entries) ;
+            mNames.resize(n_entries) ;
+            for ( int i = 0 ; i < n_entries && valid ; i++ )
+            {
+                uint64_t name_offsets[2] ;
+                memcpy(&mOffsets[i],p_index+16*i,8) ;
+                memcpy(&mSizes[i],p_index+16*i+8,4) ;
+                memcpy(&mChecksums[i],p_index+16*i+12,4) ;
+                memcpy(name_offsets,p_index+16*(size_t)n_entries+8*i,16) ;
+                valid = ( mOffsets[i] >= 64 && mOffsets[i] <= index_offset && mSizes[i] <= index_offset - mOffsets[i] &&
+                          name_offsets[0] <= name_offsets[1] && name_offsets[1] <= names_size ) ;
+                if ( valid )
+                {
+                    mNames[i].assign(p_names+name_offsets[0],p_names+name_offsets[1]) ;
+                    mIndexOfNames.insert(make_pair(mNames[i],i)) ;
+                }
+            }
+        }
+        if ( ! valid )
+        {
+            close() ;
+            throw runtime_error("Invalid archive of iris codes : " + rFilename) ;
+        }
+    }
+
+
+
+    void OsiCodeArchive::close ( )
+    {
+        bool created = mOutput.is_open() ;
+        if ( created )
+        {
+            writeIndex() ;
+            mOutput.close() ;
+        }
+        bool failed = created && mOutput.fail() ;
+        mOutput.clear() ;
+
+        mInput.close() ;
+        mOffsets.clear() ;
+        mSizes.clear() ;
+        mChecksums.clear() ;
+        mNames.clear() ;
+        mIndexOfNames.clear() ;
+
+        if ( failed )
+        {
+            throw runtime_error("Error while saving iris codes in " + mFilename) ;
+        }
+    }
+
+
+
+    bool OsiCodeArchive::isOpened ( ) const
+    {
+        return mOutput.is_open() || mInput.isOpened() ;
+    }
+
+
+
+    int OsiCodeArchive::getSize ( ) const
+    {
+        return mNames.size() ;
+    }
+
+
+
+    string OsiCodeArchive::getName ( int index ) const
+    {
+        return mNames[index] ;
+    }
+
+
+
+    int OsiCodeArchive::find ( const string & rName ) const
+    {
+        map<string,int>::const_iterator it = mIndexOfNames.find(rName) ;
+        return ( it == mIndexOfNames.end() ) ? -1 : it->second ;
+    }
+
+
+
+    void OsiCodeArchive::get ( int index , OsiIrisCode & rCode ) const
+    {
+        if ( ! mInput.isOpened() )
+        {
+            throw runtime_error("Cannot read iris codes because the archive is not opened") ;
+        }
+        if ( index < 0 || index >= getSize() )
+        {
+            throw runtime_error("Cannot read an iris code out of the archive " + mFilename) ;
+        }
+
+        const char * p_entry = mInput.getData() + mOffsets[index] ;
+        size_t size = mSizes[index] ;
+        if ( OsiMappedFile::computeChecksum(p_entry,size) != mChecksums[index] )
+        {
+            throw runtime_error("The iris code of " + mNames[index] + " is corrupted in the archive " + mFilename) ;
+        }
+
+        // Sizes and rows
+        int32_t values[5] = { 0 , 0 , 0 , 0 , 0 } ;
+        if ( size >= sizeof(values) )
+        {
+            memcpy(values,p_entry,sizeof(values)) ;
+        }
+        int n_rows = values[1] ;
+        size_t code_offset = ( sizeof(values) + 4 * (size_t)max(n_rows,0) + 7 ) / 8 * 8 ;
+        bool valid = ( n_rows > 0 && code_offset <= size ) ;
+        if ( valid )
+        {
+            vector<int> rows(n_rows) ;
+            memcpy(&rows[0],p_entry+sizeof(values),4*n_rows) ;
+            rCode.create(values[0],rows,values[2]) ;
+            valid = ! rCode.isEmpty() ;
+        }
+
+        // Code planes and mask
+        if ( valid )
+        {
+            size_t n_mask_words = (size_t)rCode.getHeight() * rCode.getNumberOfWords() ;
+            size_t code_size = ( rCode.getDataSize() - n_mask_words ) * 8 ;
+            size_t mask_size = values[4] ;
+            valid = ( code_offset + code_size + mask_size == size ) ;
+            if ( valid )
+            {
+                memcpy(rCode.getData(),p_entry+code_offset,code_size) ;
+                const char * p_mask = p_entry + code_offset + code_size ;
+                if ( values[3] == MASK_WORDS && mask_size == n_mask_words * 8 )
+                {
+                    memcpy(rCode.getMaskRow(0),p_mask,mask_size) ;
+                }
+                else
+                {
+                    valid = ( values[3] == MASK_RUNS && decodeMask((const unsigned char*)p_mask,mask_size,rCode) ) ;
+                }
+            }
+        }
+        if ( ! valid )
+        {
+            rCode.clear() ;
+            throw runtime_error("Invalid iris code of " + mNames[index] + " in the archive " + mFilename) ;
+        }
+    }
+
+
+
+
+
+    ///////////////////////////////////
+    // PRIVATE METHODS
+    ///////////////////////////////////
+
+
+    // Write the index, then the header pointing to it
+    void OsiCodeArchive::writeIndex ( )
+    {
+        int64_t index_offset = mOutput.tellp() ;
+
+        // Entries, offsets of the names, names
+        vector<char> index ;
+        for ( int i = 0 ; i < mNames.size() ; i++ )
+        {
+            appendValue(index,mOffsets[i]) ;
+            appendValue(index,mSizes[i]) ;
+            appendValue(index,mChecksums[i]) ;
+        }
+        uint64_t offset = 0 ;
+        appendValue(index,offset) ;
+        for ( int i = 0 ; i < mNames.size() ; i++ )
+        {
+            offset += mNames[i].size() ;
+            appendValue(index,offset) ;
+        }
+        for ( int i = 0 ; i < mNames.size() ; i++ )
+        {
+            index.insert(index.end(),mNames[i].begin(),mNames[i].end()) ;
+        }
+        mOutput.write(&index[0],index.size()) ;
+
+        // Header
+        char header[64] ;
+        memset(header,0,sizeof(header)) ;
+        int32_t values[3] = { 1 , (int32_t)mNames.size() , (int32_t)OsiMappedFile::computeChecksum(&index[0],index.size()) } ;
+        memcpy(header,"OSIA",4) ;
+        memcpy(header+4,values,sizeof(values)) ;
+        memcpy(header+16,&index_offset,8) ;
+        mOutput.seekp(0) ;
+        mOutput.write(header,sizeof(header)) ;
+    }
+
+
+
+    // Lengths of the runs of masked and valid pixels, row by row, as variable-length integers
+    void OsiCodeArchive::encodeMask ( const OsiIrisCode & rCode , vector<unsigned char> & rBytes )
+    {
+        rBytes.clear() ;
+        bool value = false ;
+        uint64_t length = 0 ;
+        for ( int r = 0 ; r <= rCode.getHeight() ; r++ )
+        {
+            for ( int c = 0 ; c < rCode.getWidth() ; c++ )
+            {
+                // The last run is written after the last pixel
+                bool last = ( r == rCode.getHeight() ) ;
+                if ( ! last && rCode.getMaskBit(r,c) == value )
+                {
+                    length++ ;
+                    continue ;
+                }
+                for ( ; length >= 128 ; length >>= 7 )
+                {
+                    rBytes.push_back((unsigned char)( 0x80 | ( length & 0x7F ) )) ;
+                }
+                rBytes.push_back((unsigned char)length) ;
+                if ( last )
+                {
+                    return ;
+                }
+                value = ! value ;
+                length = 1 ;
+            }
+        }
+    }
+
+
+
+    // Set the valid pixels of the mask from the lengths of the runs
+    bool OsiCodeArchive::decodeMask ( const unsigned char * pBytes , size_t size , OsiIrisCode & rCode )
+    {
+        uint64_t n_pixels = (uint64_t)rCode.getHeight() * rCode.getWidth() ;
+        uint64_t position = 0 ;
+        bool value = false ;
+        size_t i = 0 ;
+        while ( i < size )
+        {
+            uint64_t length = 0 ;
+            int bits = 0 ;
+            do
+            {
+                length |= (uint64_t)( pBytes[i] & 0x7F ) << bits ;
+                bits += 7 ;
+            }
+            while ( ( pBytes[i++] & 0x80 ) && i < size && bits < 63 ) ;
+            if ( ( pBytes[i-1] & 0x80 ) || length > n_pixels - position )
+            {
+                return false ;
+            }
+
+            if ( value )
+            {
+                for ( uint64_t p = position ; p < position + length ; p++ )
+                {
+                    rCode.setMaskBit(p/rCode.getWidth(),p%rCode.getWidth(),true) ;
+                }
+            }
+            position += length ;
+            value = ! value ;
+        }
+
+        return position == n_pixels ;
+    }
+
+} // end of namespace
+
@@ -0,0 +1,162 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_CODE_ARCHIVE_H
+#define OSI_CODE_ARCHIVE_H
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "OsiIrisCode.h"
+#include "OsiMappedFile.h"
+
+namespace osiris
+{
+
+    /** Archive of iris codes.
+    * Store the full-resolution iris codes and normalized masks of many eyes in a single file,
+    * 1 bit per pixel instead of 1 byte per pixel in the images : an eye encoded with 6 filters
+    * takes about 25 KB instead of 230 KB for "_code.bmp" and "_mano.bmp".\n
+    * The file contains a header of 64 bytes ("OSIA", version, number of entries, checksum of the
+    * index as 32-bit integers, then the offset of the index as a 64-bit integer), the entries
+    * aligned on 8 bytes, and the index : for each entry its offset (64-bit), size and checksum
+    * (32-bit), then the offsets of the names as 64-bit integers and their characters.
+    * An entry contains the width, number of rows, number of filters, coding and size in bytes of the
+    * mask as 32-bit integers, the rows of normalized iris, the words of the code planes
+    * (see OsiIrisCode::getData()), then the mask, either as words or as run lengths : the mask is
+    * made of a few long runs of valid and masked pixels (eyelids, reflections), so the lengths of
+    * the runs, read row by row and starting with masked pixels, are written as variable-length
+    * integers (7 bits per byte). Checksums are CRC-32.
+    * Values are written with the byte order of the machine.\n
+    * An archive is either created then filled with add(), or opened for reading : the file is mapped
+    * in memory and any entry can be read without reading the others.
+    * @see OsiEye::saveIrisCode() , OsiEye::loadIrisCode()
+    */
+    class OsiCodeArchive
+    {
+
+    public :
+
+        /** Default constructor. */
+        OsiCodeArchive ( ) ;
+
+        /** Default destructor. Write the index if the archive is being created. */
+        ~OsiCodeArchive ( ) ;
+
+        /** Create an empty archive.
+        * @param rFilename Complete path of the file
+        * @param compressMasks Write the masks as run lengths when it is smaller
+        * @return void
+        */
+        void create ( const std::string & rFilename , bool compressMasks = true ) ;
+
+        /** Add an iris code to an archive being created.
+        * @param rName The name of the eye
+        * @param rCode The iris code and the mask, usually with all rows of the normalized iris
+        * @return false if an entry has already this name (the code is not added)
+        */
+        bool add ( const std::string & rName , const OsiIrisCode & rCode ) ;
+
+        /** Map an archive in memory for reading.
+        * @param rFilename Complete path of the file
+        * @return void
+        */
+        void open ( const std::string & rFilename ) ;
+
+        /** Write the index if the archive is being created, and close the file.
+        * @return void
+        */
+        void close ( ) ;
+
+        /** Check if an archive is created or opened.
+        * @return true if a file is created or opened
+        */
+        bool isOpened ( ) const ;
+
+        /** Get the number of entries.
+        * @return The number of iris codes
+        */
+        int getSize ( ) const ;
+
+        /** Get the name of an entry.
+        * @param index The index of the entry
+        * @return The name given to add()
+        */
+        std::string getName ( int index ) const ;
+
+        /** Search an entry by name.
+        * @param rName The name of the eye
+        * @return The index of the entry, -1 if there is none
+        */
+        int find ( const std::string & rName ) const ;
+
+        /** Read an entry of an opened archive, and check its checksum.
+        * @param index The index of the entry
+        * @param rCode The iris code and the mask. Filled by the function
+        * @return void
+        */
+        void get ( int index , OsiIrisCode & rCode ) const ;
+
+    private :
+
+        /** Complete path of the file. */
+        std::string mFilename ;
+
+        /** The file, when the archive is being created. */
+        std::ofstream mOutput ;
+
+        /** Write the masks as run lengths. */
+        bool mCompressMasks ;
+
+        /** The file, when the archive is opened. */
+        OsiMappedFile mInput ;
+
+        /** Offset, size and checksum of the entries. */
+        std::vector<int64_t> mOffsets ;
+        std::vector<uint32_t> mSizes ;
+        std::vector<uint32_t> mChecksums ;
+
+        /** Names of the entries. */
+        std::vector<std::string> mNames ;
+
+        /** Index of the entries by name. */
+        std::map<std::string,int> mIndexOfNames ;
+
+        /** Write the index and the header at the end of the creation.
+        * @return void
+        */
+        void writeIndex ( ) ;
+
+        /** Encode the mask as run lengths.
+        * @param rCode The iris code
+        * @param rBytes The lengths of the runs. Filled by the function
+        * @return void
+        */
+        static void encodeMask ( const OsiIrisCode & rCode , std::vector<unsigned char> & rBytes ) ;
+
+        /** Decode a mask written as run lengths.
+        * @param pBytes The lengths of the runs
+        * @param size The number of bytes
+        * @param rCode The iris code, already created. Its mask is filled by the function
+        * @return false if the runs do not cover exactly the mask
+        */
+        static bool decodeMask ( const unsigned char * pBytes , size_t size , OsiIrisCode & rCode ) ;
+
+        /** An archive cannot be copied. */
+        OsiCodeArchive ( const OsiCodeArchive & ) ;
+        OsiCodeArchive & operator = ( const OsiCodeArchive & ) ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
@@ -0,0 +1,253 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "OsiCodeGenerator.h"
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // Random generator (splitmix64) : returns a random word and updates the state
+    static uint64_t nextRandom ( uint64_t & rState )
+    {
+        uint64_t z = ( rState += 0x9E3779B97F4A7C15ULL ) ;
+        z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL ;
+        z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL ;
+        return z ^ ( z >> 31 ) ;
+    }
+
+
+
+    // Random integer in [0,n[
+    static int nextInteger ( uint64_t & rState , int n )
+    {
+        return (int) ( ( nextRandom(rState) >> 33 ) % n ) ;
+    }
+
+
+
+    // Random word whose bits are on with probability 1/2^k
+    static uint64_t nextSparseWord ( uint64_t & rState , int k )
+    {
+        uint64_t word = ~0ULL ;
+        for ( int i = 0 ; i < k ; i++ )
+        {
+            word &= nextRandom(rState) ;
+        }
+        return word ;
+    }
+
+
+
+
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiCodeGenerator::OsiCodeGenerator ( int width , int height , int nFilters , uint64_t seed )
+    {
+        mWidth = width ;
+        mHeight = height ;
+        mNumberOfFilters = nFilters ;
+        mSeed = seed ;
+
+        // Grid of data/OsirisParam/points.txt : one column out of 16, from column 7, on each row
+        int words = ( width + 63 ) / 64 ;
+        mPoints.assign((size_t)height*words,0) ;
+        for ( int r = 0 ; r < height ; r++ )
+        {
+            for ( int c = 7 ; c < width ; c += 16 )
+            {
+                mPoints[(size_t)r*words+c/64] |= (uint64_t) 1 << (c%64) ;
+            }
+        }
+    }
+
+    OsiCodeGenerator::~OsiCodeGenerator ( )
+    {
+        // Do nothing
+    }
+
+
+
+    void OsiCodeGenerator::setApplicationPoints ( const vector<uint64_t> & rPoints )
+    {
+        if ( rPoints.size() != (size_t)mHeight * ( ( mWidth + 63 ) / 64 ) )
+        {
+            throw runtime_error("The application points do not match the size of the templates") ;
+        }
+        mPoints = rPoints ;
+    }
+
+
+
+
+
+    // Functions for generating templates
+    /////////////////////////////////////
+
+    void OsiCodeGenerator::createCode ( int64_t identity , OsiIrisCode & rCode ) const
+    {
+        rCode.create(mWidth,mHeight,mNumberOfFilters) ;
+        createBits(identity,rCode) ;
+
+        uint64_t state = mSeed ^ ( (uint64_t)identity * 0xD1B54A32D192ED03ULL ) ^ 0x5851F42D4C957F2DULL ;
+        createMask(state,rCode) ;
+        clearPadding(rCode) ;
+    }
+
+
+
+    void OsiCodeGenerator::createGenuine ( int64_t identity , int64_t sample , OsiIrisCode & rCode ) const
+    {
+        OsiIrisCode code ;
+        code.create(mWidth,mHeight,mNumberOfFilters) ;
+        createBits(identity,code) ;
+        clearPadding(code) ;
+
+        uint64_t state = mSeed ^ ( (uint64_t)identity * 0xD1B54A32D192ED03ULL ) ^ ( (uint64_t)(sample+1) * 0xAEF17502108EF2D9ULL ) ;
+
+        // Rotation of the eye, and noise : about 18 % of bits flipped
+        int shift = nextInteger(state,17) - 8 ;
+        rCode.create(mWidth,mHeight,mNumberOfFilters) ;
+        for ( int f = 0 ; f < mNumberOfFilters ; f++ )
+        {
+            for ( int r = 0 ; r < mHeight ; r++ )
+            {
+                uint64_t * p_row = rCode.getCodeRow(f,r) ;
+                code.getShiftedCodeRow(f,r,shift,p_row) ;
+                for ( int w = 0 ; w < rCode.getNumberOfWords() ; w++ )
+                {
+                    p_row[w] ^= nextSparseWord(state,3) | nextSparseWord(state,4) ;
+                }
+            }
+        }
+
+        createMask(state,rCode) ;
+        clearPadding(rCode) ;
+    }
+
+
+
+
+
+    ///////////////////////////////////
+    // PRIVATE METHODS
+    ///////////////////////////////////
+
+
+    // Bits of each row : a random walk along the angle, smoother for the large filters
+    void OsiCodeGenerator::createBits ( int64_t identity , OsiIrisCode & rCode ) const
+    {
+        uint64_t state = mSeed ^ ( (uint64_t)identity * 0x9E6C63D0676A9A99ULL ) ;
+        for ( int f = 0 ; f < mNumberOfFilters ; f++ )
+        {
+            int smoothness = 2 + min(f/2,2) ;
+            for ( int r = 0 ; r < mHeight ; r++ )
+            {
+                uint64_t * p_row = rCode.getCodeRow(f,r) ;
+                uint64_t previous = ( nextRandom(state) & 1 ) ? ~0ULL : 0 ;
+                for ( int w = 0 ; w < rCode.getNumberOfWords() ; w++ )
+                {
+                    // Bit j is the parity of the changes up to column j (prefix XOR)
+                    uint64_t bits = nextSparseWord(state,smoothness) ;
+                    bits ^= bits << 1 ;
+                    bits ^= bits << 2 ;
+                    bits ^= bits << 4 ;
+                    bits ^= bits << 8 ;
+                    bits ^= bits << 16 ;
+                    bits ^= bits << 32 ;
+                    bits ^= previous ;
+                    p_row[w] = bits ;
+                    previous = ( bits >> 63 ) ? ~0ULL : 0 ;
+                }
+            }
+        }
+    }
+
+
+
+    // Valid bits of a capture : the application points, but the eyelids and some reflections
+    void OsiCodeGenerator::createMask ( uint64_t & rState , OsiIrisCode & rCode ) const
+    {
+        int words = ( mWidth + 63 ) / 64 ;
+        vector<bool> valid((size_t)mHeight*mWidth) ;
+        for ( int r = 0 ; r < mHeight ; r++ )
+        {
+            for ( int c = 0 ; c < mWidth ; c++ )
+            {
+                valid[(size_t)r*mWidth+c] = ( mPoints[(size_t)r*words+c/64] >> (c%64) ) & 1 ;
+            }
+        }
+
+        // Eyelids : angular sectors around the top and the bottom of the iris,
+        // covering more columns on the outer rows (the last ones)
+        int centers [2] = { mWidth / 4 , 3 * mWidth / 4 } ;
+        int extents [2] = { nextInteger(rState,mWidth/6+1) , nextInteger(rState,mWidth/10+1) } ;
+        for ( int e = 0 ; e < 2 ; e++ )
+        {
+            for ( int r = 0 ; r < mHeight ; r++ )
+            {
+                int half_width = extents[e] * ( r + 1 ) / mHeight ;
+                for ( int c = centers[e] - half_width ; c < centers[e] + half_width ; c++ )
+                {
+                    valid[(size_t)r*mWidth+(c%mWidth+mWidth)%mWidth] = false ;
+                }
+            }
+        }
+
+        // Reflections : a few small spots
+        int n_spots = nextInteger(rState,4) ;
+        for ( int s = 0 ; s < n_spots ; s++ )
+        {
+            int row = nextInteger(rState,mHeight) ;
+            int col = nextInteger(rState,mWidth) ;
+            for ( int r = max(row-1,0) ; r <= min(row+1,mHeight-1) ; r++ )
+            {
+                for ( int c = col ; c < col + 8 ; c++ )
+                {
+                    valid[(size_t)r*mWidth+c%mWidth] = false ;
+                }
+            }
+        }
+
+        for ( int r = 0 ; r < mHeight ; r++ )
+        {
+            for ( int c = 0 ; c < mWidth ; c++ )
+            {
+                rCode.setMaskBit(r,c,valid[(size_t)r*mWidth+c]) ;
+            }
+        }
+    }
+
+
+
+    void OsiCodeGenerator::clearPadding ( OsiIrisCode & rCode ) const
+    {
+        if ( mWidth % 64 == 0 )
+        {
+            return ;
+        }
+        uint64_t last = ( (uint64_t)1 << ( mWidth % 64 ) ) - 1 ;
+        int w = rCode.getNumberOfWords() - 1 ;
+        for ( int r = 0 ; r < mHeight ; r++ )
+        {
+            for ( int f = 0 ; f < mNumberOfFilters ; f++ )
+            {
+                rCode.getCodeRow(f,r)[w] &= last ;
+            }
+            rCode.getMaskRow(r)[w] &= last ;
+        }
+    }
+
+} // end of namespace
+
@@ -0,0 +1,114 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_CODE_GENERATOR_H
+#define OSI_CODE_GENERATOR_H
+
+#include <vector>
+#include <stdint.h>
+#include "OsiIrisCode.h"
+
+namespace osiris
+{
+
+    /** Generator of synthetic iris templates, for benchmarks.
+    * The code bits of an identity follow the statistics of real iris codes : each bit is on
+    * with probability 1/2, and the bits of a row are correlated along the angle (the bit changes
+    * from one column to the next with probability 1/4, 1/8 or 1/16 for the small, medium and
+    * large filters). As in real templates, the mask only keeps the application points : by
+    * default the grid of data/OsirisParam/points.txt, one column out of 16 on each row (32 points
+    * per row of 512 columns). It also hides the upper and lower eyelids, wider on the outer rows,
+    * and a few reflections : about 80 % of the points are valid.\n
+    * A genuine sample of an identity is its code rotated by up to 8 columns, with about 18 %
+    * of the bits flipped, and with its own mask. Two identities are independent (impostors).\n
+    * Templates only depend on the seed, the identity and the sample : a gallery of millions of
+    * templates does not have to be kept for building the probes.
+    * @see OsiIrisCode
+    */
+    class OsiCodeGenerator
+    {
+
+    public :
+
+        /** Default constructor.
+        * @param width Width of normalized iris
+        * @param height Number of rows of the templates
+        * @param nFilters Number of code planes
+        * @param seed Seed of the random generator
+        */
+        OsiCodeGenerator ( int width = 512 , int height = 8 , int nFilters = 6 , uint64_t seed = 1 ) ;
+
+        /** Default destructor. */
+        ~OsiCodeGenerator ( ) ;
+
+        /** Replace the default grid of application points.
+        * @param rPoints The points of each row, packed as the masks of OsiIrisCode :
+        * (width+63)/64 words per row, bit j%64 of word j/64 set at column j
+        * @return void
+        */
+        void setApplicationPoints ( const std::vector<uint64_t> & rPoints ) ;
+
+        /** Build the enrolled template of an identity.
+        * @param identity The identity
+        * @param rCode The template. Filled by the function
+        * @return void
+        */
+        void createCode ( int64_t identity , OsiIrisCode & rCode ) const ;
+
+        /** Build another capture of an identity.
+        * @param identity The identity
+        * @param sample The number of the capture (any value, 0 gives another capture than createCode())
+        * @param rCode The template. Filled by the function
+        * @return void
+        */
+        void createGenuine ( int64_t identity , int64_t sample , OsiIrisCode & rCode ) const ;
+
+    private :
+
+        /** Width of normalized iris. */
+        int mWidth ;
+
+        /** Number of rows. */
+        int mHeight ;
+
+        /** Number of code planes. */
+        int mNumberOfFilters ;
+
+        /** Seed of the random generator. */
+        uint64_t mSeed ;
+
+        /** The application points of each row, packed. */
+        std::vector<uint64_t> mPoints ;
+
+        /** Fill the code planes of an identity, without mask.
+        * @param identity The identity
+        * @param rCode The template, already created. Filled by the function
+        * @return void
+        */
+        void createBits ( int64_t identity , OsiIrisCode & rCode ) const ;
+
+        /** Fill the mask of a capture : application points, but eyelids and reflections.
+        * @param rState The state of the random generator. Updated by the function
+        * @param rCode The template, already created. Filled by the function
+        * @return void
+        */
+        void createMask ( uint64_t & rState , OsiIrisCode & rCode ) const ;
+
+        /** Clear the bits after the last column in all rows.
+        * @param rCode The template
+        * @return void
+        */
+        void clearPadding ( OsiIrisCode & rCode ) const ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
@@ -0,0 +1,373 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_DEFAULT_MODEL_H
+#define OSI_DEFAULT_MODEL_H
+
+#include <stdint.h>
+
+namespace osiris
+{
+
+    /** Default model bundle : the filters and points of data/OsirisParam, for a normalized
+    * iris of 512 x 64. Written by OsiModelBundle::save() (option "Save model bundle"),
+    * as words of 64 bits (little-endian) to keep the alignment of the blocks.
+    * @see OsiModelBundle
+    */
+    static const uint64_t DefaultModel [] =
+    {
+        0x000000014249534FULL , 0xB442F47700002AF0ULL , 0x0000020000000006ULL , 0x00001B0000000040ULL ,
+        0x0000000F00000009ULL , 0x0000000000000080ULL , 0x0000000F00000009ULL , 0x00000000000002A0ULL ,
+        0x0000001B00000009ULL , 0x00000000000004C0ULL , 0x0000001B00000009ULL , 0x00000000000008A0ULL ,
+        0x0000003300000009ULL , 0x0000000000000C80ULL , 0x0000003300000009ULL , 0x00000000000013C0ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3F000000BE800000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0xBE8000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0x3F000000BE800000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBF000000BE800000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0xBF0000003F800000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0x3F800000BF000000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0xBF0000003F800000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3F000000BE800000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBE8000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3F000000BE800000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x00000000BE800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0xBF0000003E800000ULL , 0x00000000BF000000ULL ,
+        0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3E800000BE800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0xBF000000BF000000ULL , 0x3F00000000000000ULL ,
+        0xBE8000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0xBF0000003E800000ULL , 0x00000000BF000000ULL , 0x3F0000003F000000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3F000000BE800000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBF800000BF800000ULL , 0x3F80000000000000ULL , 0xBF0000003F800000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0xBF8000003F000000ULL , 0x00000000BF800000ULL , 0x3F8000003F800000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0x3F000000BF000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0xBF800000BF800000ULL , 0x3F80000000000000ULL , 0xBF0000003F800000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0xBF0000003E800000ULL ,
+        0x00000000BF000000ULL , 0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0x3E800000BE800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0xBF000000BF000000ULL ,
+        0x3F00000000000000ULL , 0xBE8000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0xBF0000003E800000ULL , 0x00000000BF000000ULL ,
+        0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x00000000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0x3F000000BE800000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBE8000003F000000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3F000000BE800000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBF000000BE800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL ,
+        0x3F8000003F800000ULL , 0xBF0000003F800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0x3F800000BF000000ULL , 0x3F8000003F800000ULL ,
+        0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL ,
+        0xBF0000003F800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0x3F000000BE800000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBE8000003F000000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0x3F000000BE800000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0x00000000BE800000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0xBF0000003E800000ULL , 0xBF000000BF000000ULL , 0x00000000BF000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0x3E800000BE800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0x3F00000000000000ULL , 0x3F0000003F000000ULL , 0xBE8000003F000000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0xBF0000003E800000ULL ,
+        0xBF000000BF000000ULL , 0x00000000BF000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0x3F000000BE800000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBF800000BF800000ULL , 0xBF800000BF800000ULL , 0x3F80000000000000ULL ,
+        0x3F8000003F800000ULL , 0xBF0000003F800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBF8000003F000000ULL , 0xBF800000BF800000ULL ,
+        0x00000000BF800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0x3F000000BF000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0xBF800000BF800000ULL , 0xBF800000BF800000ULL , 0x3F80000000000000ULL , 0x3F8000003F800000ULL ,
+        0xBF0000003F800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0xBF0000003E800000ULL , 0xBF000000BF000000ULL , 0x00000000BF000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3E800000BE800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0x3F00000000000000ULL , 0x3F0000003F000000ULL , 0xBE8000003F000000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0xBF0000003E800000ULL , 0xBF000000BF000000ULL , 0x00000000BF000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0x00000000BE800000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0x3F000000BE800000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBE8000003F000000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3F000000BE800000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBF000000BE800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL ,
+        0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL ,
+        0x3F8000003F800000ULL , 0xBF0000003F800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0x3F800000BF000000ULL , 0x3F8000003F800000ULL ,
+        0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL ,
+        0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL ,
+        0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL ,
+        0xBF0000003F800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0x3F000000BE800000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBE8000003F000000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0x3F000000BE800000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0x00000000BE800000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0xBF0000003E800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0x00000000BF000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0x3E800000BE800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0x3F00000000000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBE8000003F000000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0xBF0000003E800000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0x00000000BF000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0x3F000000BE800000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBF800000BF800000ULL , 0xBF800000BF800000ULL , 0xBF800000BF800000ULL ,
+        0xBF800000BF800000ULL , 0x3F80000000000000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL ,
+        0x3F8000003F800000ULL , 0xBF0000003F800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBF8000003F000000ULL , 0xBF800000BF800000ULL ,
+        0xBF800000BF800000ULL , 0xBF800000BF800000ULL , 0x00000000BF800000ULL , 0x3F8000003F800000ULL ,
+        0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0x3F000000BF000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0xBF800000BF800000ULL , 0xBF800000BF800000ULL , 0xBF800000BF800000ULL , 0xBF800000BF800000ULL ,
+        0x3F80000000000000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL , 0x3F8000003F800000ULL ,
+        0xBF0000003F800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0xBF0000003E800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0x00000000BF000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0x3E800000BE800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0xBF000000BF000000ULL ,
+        0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0x3F00000000000000ULL ,
+        0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0xBE8000003F000000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL , 0x3E8000003E800000ULL ,
+        0xBF0000003E800000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL , 0xBF000000BF000000ULL ,
+        0x00000000BF000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL , 0x3F0000003F000000ULL ,
+        0x3F0000003F000000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL , 0xBE800000BE800000ULL ,
+        0xBE800000BE800000ULL , 0x00000000BE800000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL , 0x0080008000800080ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL ,
+        0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL , 0x0000000000000000ULL
+    } ;
+
+} // End of namespace
+
+
+#endif
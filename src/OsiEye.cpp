@@ -6,6 +6,7 @@
 * License : BSD
 ********************************************************/
 
+#include <algorithm>
 #include <fstream>
 #include <stdexcept>
 #include "cv.h"
@@ -97,6 +98,7 @@ namespace osiris
     void OsiEye::loadNormalizedMask ( const string & rFilename )
     {
         loadImage(rFilename,&mpNormalizedMask) ;
+        mNormalizedMaskBits.clear() ;
     }
 
 
@@ -104,6 +106,61 @@ namespace osiris
     void OsiEye::loadIrisCode ( const string & rFilename )
     {
         loadImage(rFilename,&mpIrisCode) ;
+        mTemplate.clear() ;
+    }
+
+
+
+    void OsiEye::loadIrisCode ( const OsiCodeArchive & rArchive , const string & rName )
+    {
+        int index = rArchive.find(rName) ;
+        if ( index < 0 )
+        {
+            throw runtime_error("Cannot load iris code because " + rName + " is not in the archive") ;
+        }
+        OsiIrisCode code ;
+        rArchive.get(index,code) ;
+
+        // Only full-resolution codes can be unpacked into images
+        int width = code.getWidth() ;
+        int height = code.getHeight() ;
+        for ( int r = 0 ; r < height ; r++ )
+        {
+            if ( code.getRowIndex(r) != r )
+            {
+                throw runtime_error("Cannot load iris code because " + rName + " does not contain all rows in the archive") ;
+            }
+        }
+
+        cvReleaseImage(&mpIrisCode) ;
+        cvReleaseImage(&mpNormalizedMask) ;
+        mNormalizedMaskBits.clear() ;
+        mpIrisCode = cvCreateImage(cvSize(width,height*code.getNumberOfFilters()),IPL_DEPTH_8U,1) ;
+        mpNormalizedMask = cvCreateImage(cvSize(width,height),IPL_DEPTH_8U,1) ;
+        for ( int r = 0 ; r < height ; r++ )
+        {
+            uchar * p_mask = (uchar*)(mpNormalizedMask->imageData+r*mpNormalizedMask->widthStep) ;
+            for ( int j = 0 ; j < width ; j++ )
+            {
+                p_mask[j] = code.getMaskBit(r,j) ? 255 : 0 ;
+            }
+            for ( int n = 0 ; n < code.getNumberOfFilters() ; n++ )
+            {
+                uchar * p_code = (uchar*)(mpIrisCode->imageData+(n*height+r)*mpIrisCode->widthStep) ;
+                for ( int j = 0 ; j < width ; j++ )
+                {
+                    p_code[j] = code.getCodeBit(n,r,j) ? 255 : 0 ;
+                }
+            }
+        }
+        mTemplate.clear() ;
+    }
+
+
+
+    void OsiEye::loadTemplate ( const string & rFilename )
+    {
+        mTemplate.load(rFilename) ;
     }
 
 
@@ -224,6 +281,26 @@ namespace osiris
 
 
 
+    void OsiEye::saveIrisCode ( OsiCodeArchive & rArchive , const string & rName )
+    {
+        if ( ! mpNormalizedMask )
+        {
+            throw runtime_error("Cannot save iris code of " + rName + " in the archive because normalized mask is not built") ;
+        }
+        OsiIrisCode code ;
+        packIrisCode(code,0) ;
+        rArchive.add(rName,code) ;
+    }
+
+
+
+    void OsiEye::saveTemplate ( const string & rFilename )
+    {
+        mTemplate.save(rFilename) ;
+    }
+
+
+
     void OsiEye::saveParameters (const string & rFilename )
     {
         // Open the file
@@ -329,7 +406,7 @@ namespace osiris
 
 
 
-    void OsiEye::normalize ( int rWidthOfNormalizedIris , int rHeightOfNormalizedIris )
+    void OsiEye::normalize ( int rWidthOfNormalizedIris , int rHeightOfNormalizedIris , bool bilinear )
     {
         // Processing functions
         OsiProcessings op ;
@@ -348,8 +425,10 @@ namespace osiris
 			throw runtime_error("Cannot normalize image because contours are not correctly computed/loaded") ;
         }
         
-        //op.normalize(mpOriginalImage,mpNormalizedImage,mPupil,mIris) ;
-		op.normalizeFromContour(mpOriginalImage,mpNormalizedImage,mPupil,mIris,mThetaCoarsePupil,mThetaCoarseIris,mCoarsePupilContour,mCoarseIrisContour) ;
+        // Sampling grid of the rubber sheet, computed once for the image and the mask
+        CvMat * map_x = cvCreateMat(rHeightOfNormalizedIris,rWidthOfNormalizedIris,CV_32FC1) ;
+        CvMat * map_y = cvCreateMat(rHeightOfNormalizedIris,rWidthOfNormalizedIris,CV_32FC1) ;
+        op.computeNormalizationMap(map_x,map_y,mThetaCoarsePupil,mThetaCoarseIris,mCoarsePupilContour,mCoarseIrisContour,bilinear) ;
 
         // For the mask
         if ( ! mpMask )
@@ -358,9 +437,15 @@ namespace osiris
         }
 
         mpNormalizedMask = cvCreateImage(cvSize(rWidthOfNormalizedIris,rHeightOfNormalizedIris),IPL_DEPTH_8U,1) ;
-        
+        mNormalizedMaskBits.assign(rHeightOfNormalizedIris*((rWidthOfNormalizedIris+63)/64),0) ;
+
+        //op.normalize(mpOriginalImage,mpNormalizedImage,mPupil,mIris) ;
         //op.normalize(mpMask,mpNormalizedMask,mPupil,mIris) ;
-		op.normalizeFromContour(mpMask,mpNormalizedMask,mPupil,mIris,mThetaCoarsePupil,mThetaCoarseIris,mCoarsePupilContour,mCoarseIrisContour) ;
+        // Image, mask and its packed bits in one pass
+        op.normalizeFromMap(mpOriginalImage,mpMask,mpNormalizedImage,mpNormalizedMask,map_x,map_y,bilinear,&mNormalizedMaskBits[0]) ;
+
+        cvReleaseMat(&map_x) ;
+        cvReleaseMat(&map_y) ;
     }
 
 
@@ -379,12 +464,194 @@ namespace osiris
         // Encode
         OsiProcessings op ;
         op.encode(mpNormalizedImage,mpIrisCode,rGaborFilters) ;
+        mTemplate.clear() ;
+    }
+
+
+
+    void OsiEye::encode ( const vector<OsiEye*> & rEyes , const vector<CvMat*> & rGaborFilters , int nThreads )
+    {
+        // Create the images to store the iris codes
+        vector<const IplImage*> images ;
+        vector<IplImage*> codes ;
+        for ( int i = 0 ; i < rEyes.size() ; i++ )
+        {
+            OsiEye & r_eye = *rEyes[i] ;
+            if ( ! r_eye.mpNormalizedImage )
+            {
+                throw runtime_error("Cannot encode because normalized image is not loaded") ;
+            }
+            CvSize size = cvGetSize(r_eye.mpNormalizedImage) ;
+            cvReleaseImage(&r_eye.mpIrisCode) ;
+            r_eye.mpIrisCode = cvCreateImage(cvSize(size.width,size.height*rGaborFilters.size()),IPL_DEPTH_8U,1) ;
+            r_eye.mTemplate.clear() ;
+            images.push_back(r_eye.mpNormalizedImage) ;
+            codes.push_back(r_eye.mpIrisCode) ;
+        }
+
+        // Encode
+        OsiProcessings op ;
+        op.encode(images,codes,rGaborFilters,nThreads) ;
+    }
+
+
+
+    void OsiEye::encode ( const OsiFilterSpectra & rSpectra )
+    {
+        if ( ! mpNormalizedImage )
+        {
+            throw runtime_error("Cannot encode because normalized image is not loaded") ;
+        }
+
+        // Create the image to store the iris code
+        CvSize size = cvGetSize(mpNormalizedImage) ;
+        cvReleaseImage(&mpIrisCode) ;
+        mpIrisCode = cvCreateImage(cvSize(size.width,size.height*rSpectra.getNumberOfFilters()),IPL_DEPTH_8U,1) ;
+
+        // Encode
+        OsiProcessings op ;
+        op.encode(mpNormalizedImage,mpIrisCode,rSpectra) ;
+        mTemplate.clear() ;
+    }
+
+
+
+    void OsiEye::encode ( const OsiSeparableFilters & rFilters )
+    {
+        if ( ! mpNormalizedImage )
+        {
+            throw runtime_error("Cannot encode because normalized image is not loaded") ;
+        }
+
+        // Create the image to store the iris code
+        CvSize size = cvGetSize(mpNormalizedImage) ;
+        cvReleaseImage(&mpIrisCode) ;
+        mpIrisCode = cvCreateImage(cvSize(size.width,size.height*rFilters.getNumberOfFilters()),IPL_DEPTH_8U,1) ;
+
+        // Encode
+        OsiProcessings op ;
+        op.encode(mpNormalizedImage,mpIrisCode,rFilters) ;
+        mTemplate.clear() ;
+    }
+
+
+
+    void OsiEye::encode ( const OsiFixedPointFilters & rFilters )
+    {
+        if ( ! mpNormalizedImage )
+        {
+            throw runtime_error("Cannot encode because normalized image is not loaded") ;
+        }
+
+        // Encode into a packed code of all rows
+        CvSize size = cvGetSize(mpNormalizedImage) ;
+        OsiIrisCode code ;
+        code.create(size.width,size.height,rFilters.getNumberOfFilters()) ;
+        OsiProcessings op ;
+        op.encode(mpNormalizedImage,code,rFilters) ;
+
+        // Unpack into the image of iris code
+        cvReleaseImage(&mpIrisCode) ;
+        mpIrisCode = cvCreateImage(cvSize(size.width,size.height*rFilters.getNumberOfFilters()),IPL_DEPTH_8U,1) ;
+        for ( int n = 0 ; n < code.getNumberOfFilters() ; n++ )
+        {
+            for ( int r = 0 ; r < size.height ; r++ )
+            {
+                uchar * p_code = (uchar*)(mpIrisCode->imageData+(n*size.height+r)*mpIrisCode->widthStep) ;
+                for ( int j = 0 ; j < size.width ; j++ )
+                {
+                    p_code[j] = code.getCodeBit(n,r,j) ? 255 : 0 ;
+                }
+            }
+        }
+        mTemplate.clear() ;
+    }
+
+
+
+    float OsiEye::getAgreement ( const vector<CvMat*> & rGaborFilters ) const
+    {
+        if ( ! mpNormalizedImage || ! mpIrisCode )
+        {
+            throw runtime_error("Cannot compare iris codes because normalized image or iris code is not loaded") ;
+        }
+        if ( mpIrisCode->height != mpNormalizedImage->height * rGaborFilters.size() )
+        {
+            throw runtime_error("Cannot compare iris codes because they are not encoded with the same number of filters") ;
+        }
+
+        // Dense code, then count the pixels that differ
+        IplImage * dense = cvCreateImage(cvGetSize(mpIrisCode),IPL_DEPTH_8U,1) ;
+        OsiProcessings op ;
+        op.encode(mpNormalizedImage,dense,rGaborFilters) ;
+        cvXor(dense,mpIrisCode,dense) ;
+        float agreement = 1 - (float)cvCountNonZero(dense) / (dense->width * dense->height) ;
+        cvReleaseImage(&dense) ;
+
+        return agreement ;
+    }
+
+
+
+    void OsiEye::extractTemplate ( const CvMat * pApplicationPoints )
+    {
+        packIrisCode(mTemplate,pApplicationPoints,true) ;
+    }
+
+
+
+    void OsiEye::encodeTemplate ( const vector<CvMat*> & rGaborFilters , const CvMat * pApplicationPoints )
+    {
+        if ( ! mpNormalizedImage )
+        {
+            throw runtime_error("Cannot encode because normalized image is not loaded") ;
+        }
+        if ( ! pApplicationPoints )
+        {
+            throw runtime_error("Cannot encode the template without application points") ;
+        }
+
+        // Only the template is built
+        cvReleaseImage(&mpIrisCode) ;
+        createCode(mTemplate,pApplicationPoints,true,rGaborFilters.size()) ;
+
+        // Encode
+        OsiProcessings op ;
+        op.encode(mpNormalizedImage,mTemplate,rGaborFilters,pApplicationPoints) ;
+    }
+
+
+
+    void OsiEye::encodeTemplate ( const OsiFixedPointFilters & rFilters , const CvMat * pApplicationPoints )
+    {
+        if ( ! mpNormalizedImage )
+        {
+            throw runtime_error("Cannot encode because normalized image is not loaded") ;
+        }
+        if ( ! pApplicationPoints )
+        {
+            throw runtime_error("Cannot encode the template without application points") ;
+        }
+
+        // Only the template is built
+        cvReleaseImage(&mpIrisCode) ;
+        createCode(mTemplate,pApplicationPoints,true,rFilters.getNumberOfFilters()) ;
+
+        // Encode
+        OsiProcessings op ;
+        op.encode(mpNormalizedImage,mTemplate,rFilters) ;
     }
 
 
 
     float OsiEye::match ( OsiEye & rEye , const CvMat * pApplicationPoints )
     {
+        // Templates already contain all what is needed
+        if ( ! mTemplate.isEmpty() && ! rEye.mTemplate.isEmpty() )
+        {
+            return mTemplate.match(rEye.mTemplate) ;
+        }
+
         // Check that both iris codes are built
         if ( ! mpIrisCode )
         {
@@ -412,30 +679,121 @@ namespace osiris
             //cout << "Normalized mask of image 2 is missing for matching. All pixels are initialized to 255" << endl ;
         }
 
-        // Build the total mask = mask1 * mask2 * points    
-        IplImage * temp = cvCreateImage(cvGetSize(pApplicationPoints),mpIrisCode->depth,1) ;
-        cvSet(temp,cvScalar(0)) ;
-        cvAnd(mpNormalizedMask,rEye.mpNormalizedMask,temp,pApplicationPoints) ;
+        // Pack both iris codes, the total mask = mask1 * mask2 * points is built while matching
+        OsiIrisCode code1 , code2 ;
+        packIrisCode(code1,pApplicationPoints) ;
+        rEye.packIrisCode(code2,pApplicationPoints) ;
+
+        // Match
+        return code1.match(code2) ;
+    }
+
+
+
+    void OsiEye::packIrisCode ( OsiIrisCode & rCode , const CvMat * pApplicationPoints , bool onlyApplicationRows ) const
+    {
+        if ( ! mpIrisCode )
+        {
+            throw runtime_error("Cannot pack iris code because it is not built (nor computed neither loaded)") ;
+        }
+
+        if ( ! pApplicationPoints && ! mpNormalizedMask )
+        {
+            throw runtime_error("Cannot pack iris code without application points because normalized mask is not built") ;
+        }
+
+        // Number of codes (= number of filters)
+        int width = pApplicationPoints ? pApplicationPoints->cols : mpNormalizedMask->width ;
+        int height = pApplicationPoints ? pApplicationPoints->rows : mpNormalizedMask->height ;
+        int n_codes = mpIrisCode->height / height ;
+        if ( mpIrisCode->width != width || n_codes * height != mpIrisCode->height )
+        {
+            throw runtime_error("Cannot pack iris code because its size does not match the application points") ;
+        }
 
-        // Copy the mask f times, where f correspond to the number of codes (= number of filters)
-        int n_codes = mpIrisCode->height / pApplicationPoints->height ;
-        IplImage * total_mask = cvCreateImage(cvGetSize(mpIrisCode),IPL_DEPTH_8U,1) ;
+        // Rows and mask
+        createCode(rCode,pApplicationPoints,onlyApplicationRows,n_codes) ;
+
+        // Code planes, 64 pixels per word
         for ( int n = 0 ; n < n_codes ; n++ )
         {
-            cvSetImageROI(total_mask,cvRect(0,n*pApplicationPoints->height,pApplicationPoints->width,pApplicationPoints->height)) ;
-            cvCopy(temp,total_mask) ;        
-            cvResetImageROI(total_mask) ;
+            for ( int k = 0 ; k < rCode.getHeight() ; k++ )
+            {
+                const uchar * p_code = (uchar*)(mpIrisCode->imageData+(n*height+rCode.getRowIndex(k))*mpIrisCode->widthStep) ;
+                uint64_t * p_row = rCode.getCodeRow(n,k) ;
+                for ( int w = 0 ; w < rCode.getNumberOfWords() ; w++ )
+                {
+                    uint64_t word = 0 ;
+                    for ( int j = min(width,64*w+64) - 1 ; j >= 64 * w ; j-- )
+                    {
+                        word = ( word << 1 ) | ( p_code[j] != 0 ) ;
+                    }
+                    p_row[w] = word ;
+                }
+            }
         }
+    }
 
-        // Match
-        OsiProcessings op ;
-        float score = op.match(mpIrisCode,rEye.mpIrisCode,total_mask) ;
 
-        // Free memory
-        cvReleaseImage(&temp) ;
-        cvReleaseImage(&total_mask) ;
-    
-        return score ;
+
+    const OsiIrisCode & OsiEye::getTemplate ( ) const
+    {
+        return mTemplate ;
+    }
+
+
+
+    void OsiEye::createCode ( OsiIrisCode & rCode , const CvMat * pApplicationPoints , bool onlyApplicationRows , int nCodes ) const
+    {
+        int width = pApplicationPoints ? pApplicationPoints->cols : mpNormalizedMask->width ;
+        int height = pApplicationPoints ? pApplicationPoints->rows : mpNormalizedMask->height ;
+        if ( mpNormalizedMask && ( mpNormalizedMask->width != width || mpNormalizedMask->height != height ) )
+        {
+            throw runtime_error("Cannot pack iris code because normalized mask does not match the application points") ;
+        }
+
+        // Rows to be kept
+        vector<int> rows ;
+        for ( int i = 0 ; i < height ; i++ )
+        {
+            const uchar * p_points = pApplicationPoints ? pApplicationPoints->data.ptr + i*pApplicationPoints->step : 0 ;
+            bool has_points = ! onlyApplicationRows || ! p_points ;
+            for ( int j = 0 ; j < width && ! has_points ; j++ )
+            {
+                has_points = ( p_points[j] != 0 ) ;
+            }
+            if ( has_points )
+            {
+                rows.push_back(i) ;
+            }
+        }
+        if ( rows.empty() )
+        {
+            throw runtime_error("Cannot extract template because there is no application point") ;
+        }
+
+        rCode.create(width,rows,nCodes) ;
+
+        // Mask = normalized mask * points, 64 pixels per word. The bits packed by the normalization are used as they are
+        bool packed = ( mpNormalizedMask && mNormalizedMaskBits.size() == height * rCode.getNumberOfWords() ) ;
+        for ( int k = 0 ; k < rows.size() ; k++ )
+        {
+            int i = rows[k] ;
+            const uchar * p_points = pApplicationPoints ? pApplicationPoints->data.ptr + i*pApplicationPoints->step : 0 ;
+            const uchar * p_mask = mpNormalizedMask ? (uchar*)(mpNormalizedMask->imageData+i*mpNormalizedMask->widthStep) : 0 ;
+            uint64_t * p_row = rCode.getMaskRow(k) ;
+            for ( int w = 0 ; w < rCode.getNumberOfWords() ; w++ )
+            {
+                uint64_t word = packed ? mNormalizedMaskBits[i*rCode.getNumberOfWords()+w] : ~(uint64_t) 0 ;
+                uint64_t valid = 0 ;
+                for ( int j = min(width,64*w+64) - 1 ; j >= 64 * w ; j-- )
+                {
+                    bool bit = ( ! p_points || p_points[j] ) && ( packed || ! p_mask || p_mask[j] ) ;
+                    valid = ( valid << 1 ) | bit ;
+                }
+                p_row[w] = word & valid ;
+            }
+        }
     }
 
 
@@ -11,6 +11,11 @@
 
 #include <iostream>
 #include "OsiCircle.h"
+#include "OsiCodeArchive.h"
+#include "OsiFilterSpectra.h"
+#include "OsiFixedPointFilters.h"
+#include "OsiIrisCode.h"
+#include "OsiSeparableFilters.h"
 
 namespace osiris
 {
@@ -74,6 +79,21 @@ namespace osiris
         */
         void loadIrisCode ( const std::string & rFilename ) ;
 
+        /** Load the iris code and the normalized mask corresponding to the eye from an archive.
+        * @param rArchive The opened archive
+        * @param rName The name of the eye in the archive
+        * @return void
+        * @see OsiCodeArchive::get()
+        */
+        void loadIrisCode ( const OsiCodeArchive & rArchive , const std::string & rName ) ;
+
+        /** Load the template (compact iris code) corresponding to the eye.
+        * @param rFilename Complete path of the file
+        * @return void
+        * @see OsiIrisCode::load()
+        */
+        void loadTemplate ( const std::string & rFilename ) ;
+
         /** Load the contour parameters corresponding to the eye.
         * @param rFilename Complete path of the textfile
         * @return void
@@ -115,6 +135,22 @@ namespace osiris
         */
         void saveIrisCode ( const std::string & rFilename ) ;
 
+        /** Save the iris code and the normalized mask corresponding to the eye into an archive.
+        * Both are stored at full resolution, 1 bit per pixel.
+        * @param rArchive The archive being created
+        * @param rName The name of the eye in the archive
+        * @return void
+        * @see OsiCodeArchive::add()
+        */
+        void saveIrisCode ( OsiCodeArchive & rArchive , const std::string & rName ) ;
+
+        /** Save the template (compact iris code) corresponding to the eye.
+        * @param rFilename Complete path of the file
+        * @return void
+        * @see OsiIrisCode::save()
+        */
+        void saveTemplate ( const std::string & rFilename ) ;
+
         /** Save the contours parameters corresponding to the eye.
         * @param rFilename Complete path of the textfile
         * @return void
@@ -155,10 +191,12 @@ namespace osiris
         * Use the Daugman's rubber-sheet method.
         * @param widthOfNormalizedIris Width of normalized image
         * @param heightOfNormalizedIris Height of normalized image
+        * @param bilinear true to interpolate the image between pixels, false for the nearest pixel
+        * (the mask always takes the nearest pixel)
         * @return void
-        * @see OsiProcessings::normalize()
+        * @see OsiProcessings::computeNormalizationMap() , OsiProcessings::normalizeFromMap()
         */ 
-        void normalize ( int widthOfNormalizedIris , int heightOfNormalizedIris ) ;
+        void normalize ( int widthOfNormalizedIris , int heightOfNormalizedIris , bool bilinear = false ) ;
 
 
 
@@ -172,8 +210,99 @@ namespace osiris
 
 
 
+        /** Encode the normalized images of several eyes in one workload.
+        * Same iris codes as encode() for each eye, computed by several threads.
+        * @param rEyes The eyes, all with a normalized image
+        * @param rGaborFilters The gabor filters used to extract iris texture
+        * @param nThreads The number of threads, 0 for one per processor core
+        * @return void
+        * @see OsiProcessings::encode()
+        */
+        static void encode ( const std::vector<OsiEye*> & rEyes , const std::vector<CvMat*> & rGaborFilters , int nThreads ) ;
+
+
+
+        /** Encode the normalized image in the frequency domain.
+        * Use the spectra of a bank of Gabor filters, computed once for all eyes.
+        * @param rSpectra The spectra of the Gabor filters, for the size of the normalized image
+        * @return void
+        * @see OsiProcessings::encode()
+        */
+        void encode ( const OsiFilterSpectra & rSpectra ) ;
+
+
+
+        /** Encode the normalized image with separable approximations of the Gabor filters.
+        * @param rFilters The separable approximations of the Gabor filters
+        * @return void
+        * @see OsiProcessings::encode() , getAgreement()
+        */
+        void encode ( const OsiSeparableFilters & rFilters ) ;
+
+
+
+        /** Encode the normalized image with integer filters.
+        * The sign bits are packed by the filters, then unpacked into the iris code image.
+        * @param rFilters The quantized Gabor filters
+        * @return void
+        * @see OsiProcessings::encode() , encodeTemplate()
+        */
+        void encode ( const OsiFixedPointFilters & rFilters ) ;
+
+
+
+        /** Compare the iris code with the code given by the dense Gabor filters.
+        * The normalized image is encoded again with the dense filters, the iris code is not changed.
+        * @param rGaborFilters The gabor filters the iris code approximates
+        * @return The fraction of pixels of the iris code equal to the dense code, between 0 and 1
+        * @see encode()
+        */
+        float getAgreement ( const std::vector<CvMat*> & rGaborFilters ) const ;
+
+
+
+        /** Extract the template from the iris code.
+        * The template only keeps the rows of iris code and normalized mask containing
+        * application points. It is all what is needed for matching.
+        * @param pApplicationPoints A binary image indicating which pixels
+        * will be considered for the matching. This image is the same size as a normalized iris.
+        * @return void
+        * @see packIrisCode() , match()
+        */
+        void extractTemplate ( const CvMat * pApplicationPoints ) ;
+
+
+
+        /** Encode the normalized image directly into the template.
+        * The filters are only applied where the matching reads the code : at the application
+        * points and the columns around them within the maximum shift. The template is the same
+        * as the one extracted from the dense iris code, but the iris code is not built.
+        * @param rGaborFilters The gabor filters used to extract iris texture
+        * @param pApplicationPoints A binary image indicating which pixels
+        * will be considered for the matching. This image is the same size as a normalized iris.
+        * @return void
+        * @see extractTemplate() , OsiProcessings::encode()
+        */
+        void encodeTemplate ( const std::vector<CvMat*> & rGaborFilters , const CvMat * pApplicationPoints ) ;
+
+
+
+        /** Encode the normalized image directly into the template, with integer filters.
+        * All the columns of the rows containing application points are encoded, the sign bits
+        * being written into the template without any image in between. The iris code is not built.
+        * @param rFilters The quantized Gabor filters
+        * @param pApplicationPoints A binary image indicating which pixels
+        * will be considered for the matching. This image is the same size as a normalized iris.
+        * @return void
+        * @see extractTemplate() , OsiProcessings::encode()
+        */
+        void encodeTemplate ( const OsiFixedPointFilters & rFilters , const CvMat * pApplicationPoints ) ;
+
+
+
         /** Match two eyes (hamming distance between iris codes).
-        * Normalized masks are used.\n        
+        * If both eyes have a template, templates are matched directly.
+        * Otherwise normalized masks are used.\n        
         * If normalized mask is not already initialized,
         * the function does intialize it to 255, that is why rEye is not "const"
         * @param rEye The other eye to match
@@ -184,6 +313,26 @@ namespace osiris
         */
         float match ( OsiEye & rEye , const CvMat * pApplicationPoints ) ;
 
+
+
+        /** Pack the iris code and the normalized mask into 64-bit words.
+        * The mask of the packed code is the normalized mask restricted to the application points.
+        * If normalized mask is not built, all pixels of the normalized iris are considered as valid.
+        * @param rCode The packed iris code. Filled by the function
+        * @param pApplicationPoints A binary image indicating which pixels
+        * will be considered for the matching. This image is the same size as a normalized iris.
+        * If 0, all pixels are considered and the size is given by the normalized mask, which must be built.
+        * @param onlyApplicationRows Keep only the rows containing application points (template)
+        * @return void
+        * @see match() , extractTemplate() , OsiIrisCode
+        */
+        void packIrisCode ( OsiIrisCode & rCode , const CvMat * pApplicationPoints , bool onlyApplicationRows = false ) const ;
+
+        /** Get the template of the eye.
+        * @return The template, empty if neither extracted nor loaded
+        */
+        const OsiIrisCode & getTemplate ( ) const ;
+
     private :
 
         /** The original image corresponding to the eye (input only). */
@@ -201,9 +350,15 @@ namespace osiris
         /** The normalized mask corresponding to the eye (input and/or output). */
         IplImage * mpNormalizedMask ;
 
+        /** The normalized mask packed by normalize(), as the masks of OsiIrisCode (empty if the mask is loaded). */
+        std::vector<uint64_t> mNormalizedMaskBits ;
+
         /** The iris code (stored as an image) corresponding to the eye (input and/or output). */
         IplImage * mpIrisCode ;
 
+        /** The template (compact packed iris code) corresponding to the eye (input and/or output). */
+        OsiIrisCode mTemplate ;
+
         /** The pupil circle corresponding to the eye (input and/or output). */
         OsiCircle mPupil ;
 
@@ -237,6 +392,18 @@ namespace osiris
         */
         void saveImage ( const std::string & rFilename , const IplImage * pImage ) ;
 
+
+        /** Create a packed code with its mask, the code planes are set to 0.
+        * @param rCode The packed code. Filled by the function
+        * @param pApplicationPoints A binary image indicating which pixels
+        * will be considered for the matching, or 0 for all pixels of the normalized mask
+        * @param onlyApplicationRows Keep only the rows containing application points (template)
+        * @param nCodes Number of code planes
+        * @return void
+        * @see packIrisCode()
+        */
+        void createCode ( OsiIrisCode & rCode , const CvMat * pApplicationPoints , bool onlyApplicationRows , int nCodes ) const ;
+
     } ; // End of class
 
 } // End of namespace
@@ -0,0 +1,146 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+#include "cv.h"
+#include "OsiFilterSpectra.h"
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiFilterSpectra::OsiFilterSpectra ( )
+    {
+        mWidth = 0 ;
+        mHeight = 0 ;
+        mBorder = 0 ;
+        mPaddedHeight = 0 ;
+    }
+
+    OsiFilterSpectra::~OsiFilterSpectra ( )
+    {
+        clear() ;
+    }
+
+
+
+
+
+    // OPERATORS
+    ////////////
+
+    void OsiFilterSpectra::create ( const vector<CvMat*> & rFilters , int width , int height )
+    {
+        clear() ;
+
+        // The rows around the image must cover the highest kernel
+        int border = 0 ;
+        for ( int f = 0 ; f < rFilters.size() ; f++ )
+        {
+            if ( rFilters[f]->cols > width )
+            {
+                throw runtime_error("Cannot compute the spectra of Gabor filters wider than the normalized iris") ;
+            }
+            border = max(border,rFilters[f]->rows/2) ;
+        }
+        mWidth = width ;
+        mHeight = height ;
+        mBorder = border ;
+        mPaddedHeight = cvGetOptimalDFTSize(height+2*border) ;
+
+        // Kernel of cvFilter2D (correlation, anchor at the center) wrapped around the origin
+        for ( int f = 0 ; f < rFilters.size() ; f++ )
+        {
+            const CvMat * p_filter = rFilters[f] ;
+            CvMat * p_spectrum = cvCreateMat(mPaddedHeight,mWidth,CV_32FC1) ;
+            cvZero(p_spectrum) ;
+            for ( int i = 0 ; i < p_filter->rows ; i++ )
+            {
+                const float * p_row = (const float*)(p_filter->data.ptr+i*p_filter->step) ;
+                float * p_dst = (float*)(p_spectrum->data.ptr+((i-p_filter->rows/2+mPaddedHeight)%mPaddedHeight)*p_spectrum->step) ;
+                for ( int j = 0 ; j < p_filter->cols ; j++ )
+                {
+                    p_dst[(j-p_filter->cols/2+mWidth)%mWidth] += p_row[j] ;
+                }
+            }
+            cvDFT(p_spectrum,p_spectrum,CV_DXT_FORWARD) ;
+            mSpectra.push_back(p_spectrum) ;
+        }
+    }
+
+
+
+    void OsiFilterSpectra::clear ( )
+    {
+        for ( int f = 0 ; f < mSpectra.size() ; f++ )
+        {
+            cvReleaseMat(&mSpectra[f]) ;
+        }
+        mSpectra.clear() ;
+        mWidth = 0 ;
+        mHeight = 0 ;
+        mBorder = 0 ;
+        mPaddedHeight = 0 ;
+    }
+
+
+
+    bool OsiFilterSpectra::isEmpty ( ) const
+    {
+        return mSpectra.empty() ;
+    }
+
+
+
+    int OsiFilterSpectra::getWidth ( ) const
+    {
+        return mWidth ;
+    }
+
+
+
+    int OsiFilterSpectra::getHeight ( ) const
+    {
+        return mHeight ;
+    }
+
+
+
+    int OsiFilterSpectra::getBorder ( ) const
+    {
+        return mBorder ;
+    }
+
+
+
+    int OsiFilterSpectra::getPaddedHeight ( ) const
+    {
+        return mPaddedHeight ;
+    }
+
+
+
+    int OsiFilterSpectra::getNumberOfFilters ( ) const
+    {
+        return mSpectra.size() ;
+    }
+
+
+
+    const CvMat * OsiFilterSpectra::getSpectrum ( int filter ) const
+    {
+        return mSpectra[filter] ;
+    }
+
+} // end of namespace
+
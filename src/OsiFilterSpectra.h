@@ -0,0 +1,115 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_FILTER_SPECTRA_H
+#define OSI_FILTER_SPECTRA_H
+
+#include <vector>
+#include "highgui.h"
+
+namespace osiris
+{
+
+    /** Spectra of a bank of filters, for encoding in the frequency domain.
+    * The normalized iris wraps around in angle : a 2D DFT as wide as the normalized iris
+    * is circular along the angle, so the image needs no left and right borders. Along the
+    * radius, the image is padded with copies of its first and last rows (as cvFilter2D does),
+    * up to a height suitable for the DFT.\n
+    * The spectra are computed once for a size of normalized iris, then each encoding costs
+    * one forward DFT, and for each filter a product of spectra and an inverse DFT, whatever
+    * the size of the kernels.
+    * @see OsiProcessings::encode()
+    */
+    class OsiFilterSpectra
+    {
+
+    public :
+
+        /** Default constructor. Build empty spectra. */
+        OsiFilterSpectra ( ) ;
+
+        /** Default destructor. Release the spectra. */
+        ~OsiFilterSpectra ( ) ;
+
+        /** Compute the spectra of the filters for a size of normalized iris.
+        * @param rFilters The bank of Gabor filters, no wider than the normalized iris
+        * @param width Width of normalized iris
+        * @param height Height of normalized iris
+        * @return void
+        */
+        void create ( const std::vector<CvMat*> & rFilters , int width , int height ) ;
+
+        /** Release the spectra.
+        * @return void
+        */
+        void clear ( ) ;
+
+        /** Check if the spectra are computed.
+        * @return true if there is no spectrum
+        */
+        bool isEmpty ( ) const ;
+
+        /** Get the width of normalized iris.
+        * @return The width of the spectra
+        */
+        int getWidth ( ) const ;
+
+        /** Get the height of normalized iris.
+        * @return The height without padding
+        */
+        int getHeight ( ) const ;
+
+        /** Get the number of rows added above the normalized iris.
+        * @return The number of rows, also added below the normalized iris
+        */
+        int getBorder ( ) const ;
+
+        /** Get the height of the DFT.
+        * @return The height of the spectra, at least getHeight() + 2 * getBorder()
+        */
+        int getPaddedHeight ( ) const ;
+
+        /** Get the number of filters.
+        * @return The number of spectra
+        */
+        int getNumberOfFilters ( ) const ;
+
+        /** Get the spectrum of a filter.
+        * @param filter The index of the filter
+        * @return The spectrum (CCS packed, see cvDFT), to be multiplied with CV_DXT_MUL_CONJ
+        */
+        const CvMat * getSpectrum ( int filter ) const ;
+
+    private :
+
+        /** Width of normalized iris. */
+        int mWidth ;
+
+        /** Height of normalized iris. */
+        int mHeight ;
+
+        /** Number of rows added above and below. */
+        int mBorder ;
+
+        /** Height of the DFT. */
+        int mPaddedHeight ;
+
+        /** The spectra of the filters. */
+        std::vector<CvMat*> mSpectra ;
+
+        /** Spectra cannot be copied. */
+        OsiFilterSpectra ( const OsiFilterSpectra & ) ;
+        OsiFilterSpectra & operator = ( const OsiFilterSpectra & ) ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
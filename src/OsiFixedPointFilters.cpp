@@ -0,0 +1,347 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include "OsiFixedPointFilters.h"
+#include "OsiHamming.h"
+
+// Same compilation of the vector kernel as in OsiHamming : x86-64 only, with its own target
+#if defined(__GNUC__) && defined(__x86_64__)
+#define OSI_FIXED_POINT_X86
+#define OSI_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define OSI_FIXED_POINT_X86
+#define OSI_TARGET(isa)
+#include <immintrin.h>
+#endif
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // Signature of all kernels : taps (rows x cols, cols even), anchor, rows of image, width, code
+    typedef void (*EncodeFunction) ( const int16_t * , int , int , int ,
+                                     const int16_t * const * , int , uint64_t * ) ;
+
+
+
+    // Response of the kernel at one column
+    static inline int32_t correlate ( const int16_t * pTaps , int rows , int cols , int anchor ,
+                                      const int16_t * const * ppRows , int col )
+    {
+        int32_t sum = 0 ;
+        for ( int a = 0 ; a < rows ; a++ )
+        {
+            const int16_t * p_taps = pTaps + a * cols ;
+            const int16_t * p_row = ppRows[a] + col - anchor ;
+            for ( int b = 0 ; b < cols ; b++ )
+            {
+                sum += (int32_t) p_taps[b] * p_row[b] ;
+            }
+        }
+        return sum ;
+    }
+
+
+
+    // Portable kernel
+    static void encodeScalar ( const int16_t * pTaps , int rows , int cols , int anchor ,
+                               const int16_t * const * ppRows , int width , uint64_t * pCode )
+    {
+        memset(pCode,0,(width+63)/64*sizeof(uint64_t)) ;
+        for ( int j = 0 ; j < width ; j++ )
+        {
+            if ( correlate(pTaps,rows,cols,anchor,ppRows,j) > 0 )
+            {
+                pCode[j/64] |= (uint64_t) 1 << (j%64) ;
+            }
+        }
+    }
+
+
+
+#ifdef OSI_FIXED_POINT_X86
+
+    // Kernel with AVX2, 16 columns at a time. The pixels j and j+1 are interleaved, so that one
+    // multiply-add applies two taps. The interleaving works within each half of the register :
+    // the low products give the columns 0-3 and 8-11, the high products the columns 4-7 and 12-15
+    OSI_TARGET("avx2")
+    static void encodeAvx2 ( const int16_t * pTaps , int rows , int cols , int anchor ,
+                             const int16_t * const * ppRows , int width , uint64_t * pCode )
+    {
+        memset(pCode,0,(width+63)/64*sizeof(uint64_t)) ;
+        const __m256i zero = _mm256_setzero_si256() ;
+        int j = 0 ;
+        for ( ; j + 16 <= width ; j += 16 )
+        {
+            __m256i low = zero ;
+            __m256i high = zero ;
+            for ( int a = 0 ; a < rows ; a++ )
+            {
+                const int16_t * p_taps = pTaps + a * cols ;
+                const int16_t * p_row = ppRows[a] + j - anchor ;
+                for ( int b = 0 ; b < cols ; b += 2 )
+                {
+                    __m256i taps = _mm256_set1_epi32( (int) ( (uint16_t) p_taps[b] | ( (uint32_t) (uint16_t) p_taps[b+1] << 16 ) ) ) ;
+                    __m256i pixels0 = _mm256_loadu_si256((const __m256i*)(p_row+b)) ;
+                    __m256i pixels1 = _mm256_loadu_si256((const __m256i*)(p_row+b+1)) ;
+                    low = _mm256_add_epi32(low,_mm256_madd_epi16(_mm256_unpacklo_epi16(pixels0,pixels1),taps)) ;
+                    high = _mm256_add_epi32(high,_mm256_madd_epi16(_mm256_unpackhi_epi16(pixels0,pixels1),taps)) ;
+                }
+            }
+            int mask_low = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(low,zero))) ;
+            int mask_high = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(high,zero))) ;
+            uint64_t bits = ( mask_low & 0xF ) | ( ( mask_high & 0xF ) << 4 ) |
+                            ( ( mask_low & 0xF0 ) << 4 ) | ( ( mask_high & 0xF0 ) << 8 ) ;
+            pCode[j/64] |= bits << (j%64) ;
+        }
+        for ( ; j < width ; j++ )
+        {
+            if ( correlate(pTaps,rows,cols,anchor,ppRows,j) > 0 )
+            {
+                pCode[j/64] |= (uint64_t) 1 << (j%64) ;
+            }
+        }
+    }
+
+#endif
+
+
+
+    // The kernel is chosen when the program starts
+    static bool isAvx2Supported ( )
+    {
+#ifdef OSI_FIXED_POINT_X86
+        return OsiHamming::isSupported(OsiHamming::AVX2) ;
+#else
+        return false ;
+#endif
+    }
+
+    static EncodeFunction getFunction ( bool avx2 )
+    {
+#ifdef OSI_FIXED_POINT_X86
+        if ( avx2 )
+        {
+            return encodeAvx2 ;
+        }
+#endif
+        return encodeScalar ;
+    }
+
+    static bool sAvx2 = isAvx2Supported() ;
+    static EncodeFunction spEncode = getFunction(sAvx2) ;
+
+
+
+
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiFixedPointFilters::OsiFixedPointFilters ( )
+    {
+        mBorder = 0 ;
+    }
+
+    OsiFixedPointFilters::~OsiFixedPointFilters ( )
+    {
+        // Do nothing
+    }
+
+
+
+
+
+    // OPERATORS
+    ////////////
+
+    void OsiFixedPointFilters::create ( const vector<CvMat*> & rFilters )
+    {
+        clear() ;
+
+        for ( int f = 0 ; f < rFilters.size() ; f++ )
+        {
+            const CvMat * p_filter = rFilters[f] ;
+            int rows = p_filter->rows ;
+            int cols = p_filter->cols ;
+            int padded = ( cols + 1 ) / 2 * 2 ;
+
+            // Largest and total magnitude of the taps
+            double max_tap = 0 , sum_taps = 0 ;
+            for ( int i = 0 ; i < rows ; i++ )
+            {
+                const float * p_row = (const float*)(p_filter->data.ptr+i*p_filter->step) ;
+                for ( int j = 0 ; j < cols ; j++ )
+                {
+                    max_tap = max(max_tap,(double)fabs(p_row[j])) ;
+                    sum_taps += fabs(p_row[j]) ;
+                }
+            }
+
+            // Largest power of two keeping taps on 16 bits and responses of 8-bit images on 32 bits
+            int scale = 0 ;
+            if ( max_tap > 0 )
+            {
+                scale = 30 ;
+                while ( scale > -30 && ( ldexp(max_tap,scale) > 32767 || ldexp(sum_taps*255,scale) > 2147483647.0 - 32768*255 ) )
+                {
+                    scale-- ;
+                }
+            }
+
+            // Round the taps
+            vector<int16_t> taps(rows*padded,0) ;
+            double error = 0 ;
+            for ( int i = 0 ; i < rows ; i++ )
+            {
+                const float * p_row = (const float*)(p_filter->data.ptr+i*p_filter->step) ;
+                for ( int j = 0 ; j < cols ; j++ )
+                {
+                    double tap = floor(ldexp((double)p_row[j],scale)+0.5) ;
+                    taps[i*padded+j] = (int16_t) tap ;
+                    error = max(error,fabs(ldexp(tap,-scale)-p_row[j])) ;
+                }
+            }
+
+            mTaps.push_back(taps) ;
+            mRows.push_back(rows) ;
+            mColumns.push_back(padded) ;
+            mAnchors.push_back(cols/2) ;
+            mScales.push_back(scale) ;
+            mErrors.push_back( max_tap > 0 ? error / max_tap : 0 ) ;
+            mBorder = max(mBorder,padded) ;
+        }
+    }
+
+
+
+    void OsiFixedPointFilters::clear ( )
+    {
+        mTaps.clear() ;
+        mRows.clear() ;
+        mColumns.clear() ;
+        mAnchors.clear() ;
+        mScales.clear() ;
+        mErrors.clear() ;
+        mBorder = 0 ;
+    }
+
+
+
+    bool OsiFixedPointFilters::isEmpty ( ) const
+    {
+        return mTaps.empty() ;
+    }
+
+
+
+    int OsiFixedPointFilters::getNumberOfFilters ( ) const
+    {
+        return mTaps.size() ;
+    }
+
+
+
+    int OsiFixedPointFilters::getRows ( int filter ) const
+    {
+        return mRows[filter] ;
+    }
+
+
+
+    int OsiFixedPointFilters::getScale ( int filter ) const
+    {
+        return mScales[filter] ;
+    }
+
+
+
+    float OsiFixedPointFilters::getError ( int filter ) const
+    {
+        return mErrors[filter] ;
+    }
+
+
+
+    int OsiFixedPointFilters::getBorder ( ) const
+    {
+        return mBorder ;
+    }
+
+
+
+    void OsiFixedPointFilters::encodeRow ( const int16_t * const * ppRows , int width , int filter , uint64_t * pCode ) const
+    {
+        spEncode(&mTaps[filter][0],mRows[filter],mColumns[filter],mAnchors[filter],ppRows,width,pCode) ;
+    }
+
+
+
+    string OsiFixedPointFilters::getKernel ( )
+    {
+        return sAvx2 ? "avx2" : "scalar" ;
+    }
+
+
+
+    bool OsiFixedPointFilters::checkKernels ( )
+    {
+        if ( ! sAvx2 )
+        {
+            return true ;
+        }
+
+        // Random taps and pixels (linear congruential generator, so the check is reproducible)
+        const int rows = 3 ;
+        const int cols = 14 ;
+        const int border = 16 ;
+        const int max_width = 77 ;
+        vector<int16_t> taps(rows*cols) ;
+        vector<int16_t> pixels(rows*(max_width+2*border)) ;
+        uint64_t state = 0x2545F4914F6CDD1DULL ;
+        for ( int i = 0 ; i < taps.size() + pixels.size() ; i++ )
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL ;
+            int value = (int) ( state >> 40 ) ;
+            if ( i < taps.size() )
+            {
+                taps[i] = (int16_t) ( value % 2001 - 1000 ) ;
+            }
+            else
+            {
+                pixels[i-taps.size()] = (int16_t) ( value % 256 ) ;
+            }
+        }
+        const int16_t * p_rows [rows] ;
+        for ( int a = 0 ; a < rows ; a++ )
+        {
+            p_rows[a] = &pixels[a*(max_width+2*border)+border] ;
+        }
+
+        // All widths, to go through the end of the vector loop
+        vector<uint64_t> code1(2) , code2(2) ;
+        for ( int width = 1 ; width <= max_width ; width++ )
+        {
+            encodeScalar(&taps[0],rows,cols,cols/2,p_rows,width,&code1[0]) ;
+            getFunction(true)(&taps[0],rows,cols,cols/2,p_rows,width,&code2[0]) ;
+            if ( code1 != code2 )
+            {
+                return false ;
+            }
+        }
+        return true ;
+    }
+
+} // end of namespace
+
@@ -0,0 +1,142 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_FIXED_POINT_FILTERS_H
+#define OSI_FIXED_POINT_FILTERS_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "highgui.h"
+
+namespace osiris
+{
+
+    /** Bank of filters quantized to 16-bit integers, for encoding straight into packed sign bits.
+    * Each kernel is multiplied by a power of two, as large as possible such that every tap fits
+    * in 16 bits and the response of an 8-bit image fits in 32 bits, then rounded. The responses
+    * are computed exactly in integers, so their signs only differ from the float ones where the
+    * rounding of the taps changes them. Kernels whose taps are multiples of a power of two (as
+    * the ones of OSIRIS) are represented exactly.\n
+    * The correlation is computed by one of two kernels giving the same bits : a portable one,
+    * and one with AVX2 (16 columns at a time, two taps per multiply-add), chosen once at
+    * start-up like the kernels of OsiHamming. There is no temporary image : the sign bits of
+    * each row are written directly into the words of the code.
+    * @see OsiProcessings::encode() , OsiHamming
+    */
+    class OsiFixedPointFilters
+    {
+
+    public :
+
+        /** Default constructor. Build an empty bank. */
+        OsiFixedPointFilters ( ) ;
+
+        /** Default destructor. */
+        ~OsiFixedPointFilters ( ) ;
+
+        /** Quantize a bank of filters.
+        * @param rFilters The bank of Gabor filters
+        * @return void
+        */
+        void create ( const std::vector<CvMat*> & rFilters ) ;
+
+        /** Release the taps.
+        * @return void
+        */
+        void clear ( ) ;
+
+        /** Check if the bank is built.
+        * @return true if there is no filter
+        */
+        bool isEmpty ( ) const ;
+
+        /** Get the number of filters.
+        * @return The number of filters of the bank
+        */
+        int getNumberOfFilters ( ) const ;
+
+        /** Get the number of rows of a kernel.
+        * @param filter The index of the filter
+        * @return The height of the kernel
+        */
+        int getRows ( int filter ) const ;
+
+        /** Get the power of two applied to a kernel before rounding.
+        * @param filter The index of the filter
+        * @return The exponent of the scale
+        */
+        int getScale ( int filter ) const ;
+
+        /** Get the rounding error of a kernel.
+        * @param filter The index of the filter
+        * @return The largest error of a tap, relative to the largest tap
+        */
+        float getError ( int filter ) const ;
+
+        /** Get the number of columns needed on each side of a row.
+        * @return The number of columns, the same for all filters
+        */
+        int getBorder ( ) const ;
+
+        /** Compute the signs of the responses of a filter along one row.
+        * @param ppRows The rows of image under the kernel (16-bit pixels), from the top one.
+        * Each row starts at column 0 and must be readable from column -getBorder() to
+        * width + getBorder() - 1 (wrapped columns of the normalized iris).
+        * @param width The number of columns
+        * @param filter The index of the filter
+        * @param pCode The row of code. Bit j is set if the response at column j is above 0,
+        * the bits after the last column are set to 0
+        * @return void
+        */
+        void encodeRow ( const int16_t * const * ppRows , int width , int filter , uint64_t * pCode ) const ;
+
+        /** Get the name of the kernel computing the responses.
+        * @return "avx2" or "scalar"
+        */
+        static std::string getKernel ( ) ;
+
+        /** Compare the AVX2 kernel to the portable one on random rows, if it is supported.
+        * @return true if both kernels give the same bits
+        */
+        static bool checkKernels ( ) ;
+
+    private :
+
+        /** The taps of each filter, row by row, padded with 0 to an even number of columns. */
+        std::vector< std::vector<int16_t> > mTaps ;
+
+        /** The number of rows of each kernel. */
+        std::vector<int> mRows ;
+
+        /** The number of columns of each kernel, padded to an even number. */
+        std::vector<int> mColumns ;
+
+        /** The anchor of each kernel (column of its center). */
+        std::vector<int> mAnchors ;
+
+        /** The exponents of the scales. */
+        std::vector<int> mScales ;
+
+        /** The rounding errors. */
+        std::vector<float> mErrors ;
+
+        /** Number of columns needed on each side of a row. */
+        int mBorder ;
+
+        /** Filters cannot be copied. */
+        OsiFixedPointFilters ( const OsiFixedPointFilters & ) ;
+        OsiFixedPointFilters & operator = ( const OsiFixedPointFilters & ) ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
@@ -0,0 +1,618 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include "OsiGallery.h"
+#include "OsiProbe.h"
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiGallery::OsiGallery ( )
+    {
+        mRecordSize = 0 ;
+        mSize = 0 ;
+        mpMappedRecords = 0 ;
+        mpMappedIdOffsets = 0 ;
+        mpMappedIds = 0 ;
+    }
+
+    OsiGallery::~OsiGallery ( )
+    {
+        // Do nothing
+    }
+
+
+
+
+
+    // Functions for enrollment
+    ///////////////////////////
+
+    int OsiGallery::enroll ( const string & rId , const OsiIrisCode & rCode )
+    {
+        if ( rCode.isEmpty() )
+        {
+            throw runtime_error("Cannot enroll " + rId + " because its template is not built") ;
+        }
+        if ( mSize && ! mFormat.isCompatible(rCode) )
+        {
+            throw runtime_error("Cannot enroll " + rId + " because its template does not have the size of the gallery") ;
+        }
+
+        // The entries are modified : they must be in memory
+        if ( mFile.isOpened() )
+        {
+            copyMappedEntries() ;
+        }
+
+        // The first template gives the size of the records, padded to 64 bytes
+        if ( ! mSize )
+        {
+            mFormat = rCode ;
+            mRecordSize = ( rCode.getDataSize() + 7 ) / 8 * 8 ;
+            mRecords.clear() ;
+            mIds.clear() ;
+        }
+
+        mRecords.resize(mRecords.size()+mRecordSize,0) ;
+        copy(rCode.getData(),rCode.getData()+rCode.getDataSize(),mRecords.end()-mRecordSize) ;
+        mIds.push_back(rId) ;
+
+        return mSize++ ;
+    }
+
+
+
+    void OsiGallery::clear ( )
+    {
+        mFile.close() ;
+        mpMappedRecords = 0 ;
+        mpMappedIdOffsets = 0 ;
+        mpMappedIds = 0 ;
+        mRecords.clear() ;
+        mIds.clear() ;
+        mFormat.clear() ;
+        mRecordSize = 0 ;
+        mSize = 0 ;
+    }
+
+
+
+    int OsiGallery::getSize ( ) const
+    {
+        return mSize ;
+    }
+
+
+
+    string OsiGallery::getId ( int index ) const
+    {
+        if ( mFile.isOpened() )
+        {
+            return string(mpMappedIds+mpMappedIdOffsets[index],mpMappedIds+mpMappedIdOffsets[index+1]) ;
+        }
+        return mIds[index] ;
+    }
+
+
+
+    OsiIrisCode OsiGallery::getTemplate ( int index ) const
+    {
+        OsiIrisCode code = mFormat ;
+        const uint64_t * p_record = getRecord(index) ;
+        copy(p_record,p_record+code.getDataSize(),code.getData()) ;
+        return code ;
+    }
+
+
+
+
+
+    // Functions for identification
+    ///////////////////////////////
+
+    vector<OsiCandidate> OsiGallery::identify ( const OsiIrisCode & rProbe , int nCandidates , int nThreads ) const
+    {
+        return identify(vector<OsiIrisCode>(1,rProbe),nCandidates,nThreads)[0] ;
+    }
+
+
+
+    vector< vector<OsiCandidate> > OsiGallery::identify ( const vector<OsiIrisCode> & rProbes , int nCandidates , int nThreads , int batchSize ) const
+    {
+        return identify(rProbes,nCandidates,nThreads,batchSize,0,mFormat.getNumberOfFilters(),1) ;
+    }
+
+
+
+    vector<OsiCandidate> OsiGallery::identify ( const OsiIrisCode & rProbe , int nCandidates , const OsiCascade & rCascade , int nThreads ) const
+    {
+        return identify(vector<OsiIrisCode>(1,rProbe),nCandidates,rCascade,nThreads)[0] ;
+    }
+
+
+
+    vector< vector<OsiCandidate> > OsiGallery::identify ( const vector<OsiIrisCode> & rProbes , int nCandidates , const OsiCascade & rCascade , int nThreads , int batchSize ) const
+    {
+        if ( mSize && ( rCascade.mFirstFilter < 0 || rCascade.mNumberOfFilters <= 0 ||
+                        rCascade.mFirstFilter + rCascade.mNumberOfFilters > mFormat.getNumberOfFilters() ) )
+        {
+            throw runtime_error("Cannot search the gallery because the band of the cascade is out of the code planes") ;
+        }
+
+        // First stage : the best entries on the band, below the rejection threshold
+        int n_survivors = max(rCascade.mNumberOfSurvivors,nCandidates) ;
+        vector< vector<OsiCandidate> > candidates = identify(rProbes,n_survivors,nThreads,batchSize,
+                                                             rCascade.mFirstFilter,rCascade.mNumberOfFilters,
+                                                             rCascade.mRejectionThreshold) ;
+
+        // Second stage : the survivors on all code planes
+        for ( int p = 0 ; p < rProbes.size() ; p++ )
+        {
+            vector<int> survivors ;
+            for ( int i = 0 ; i < candidates[p].size() ; i++ )
+            {
+                survivors.push_back(candidates[p][i].mIndex) ;
+            }
+            candidates[p] = identify(rProbes[p],nCandidates,survivors) ;
+        }
+
+        return candidates ;
+    }
+
+
+
+    vector<OsiCandidate> OsiGallery::identify ( const OsiIrisCode & rProbe , int nCandidates , const vector<int> & rEntries ) const
+    {
+        vector<OsiCandidate> candidates ;
+        if ( nCandidates <= 0 || rEntries.empty() )
+        {
+            return candidates ;
+        }
+        checkProbe(rProbe) ;
+
+        // Entries in increasing order, so that ties are broken as in a full search
+        vector<int> entries(rEntries) ;
+        sort(entries.begin(),entries.end()) ;
+        entries.erase(unique(entries.begin(),entries.end()),entries.end()) ;
+
+        OsiProbe probe(rProbe) ;
+        for ( int i = 0 ; i < entries.size() ; i++ )
+        {
+            rankEntry(probe,entries[i],nCandidates,0,mFormat.getNumberOfFilters(),1,candidates) ;
+        }
+
+        // Best candidate first
+        sort_heap(candidates.begin(),candidates.end()) ;
+
+        return candidates ;
+    }
+
+
+
+    bool OsiGallery::verify ( const string & rId , const OsiIrisCode & rProbe , float threshold , float & rScore ) const
+    {
+        bool enrolled = false ;
+        bool accepted = false ;
+        rScore = 1 ;
+
+        // The best score among the entries of this identity. Once accepted, the
+        // threshold becomes the best score so that the result stays exact
+        OsiProbe probe ;
+        for ( int i = 0 ; i < mSize ; i++ )
+        {
+            if ( ! hasId(i,rId) )
+            {
+                continue ;
+            }
+            if ( ! enrolled )
+            {
+                checkProbe(rProbe) ;
+                probe.create(rProbe) ;
+                enrolled = true ;
+            }
+
+            float score ;
+            if ( probe.verify(getRecord(i),accepted?rScore:threshold,score) )
+            {
+                accepted = true ;
+                rScore = score ;
+            }
+            else if ( ! accepted )
+            {
+                rScore = min(rScore,score) ;
+            }
+        }
+
+        if ( ! enrolled )
+        {
+            throw runtime_error("Cannot verify because " + rId + " is not enrolled") ;
+        }
+
+        return accepted ;
+    }
+
+
+
+
+
+    // Functions for loading and saving
+    ///////////////////////////////////
+
+    void OsiGallery::save ( const string & rFilename ) const
+    {
+        // Write in a temporary file : the gallery may be mapped from the destination file
+        string temporary = rFilename + ".tmp" ;
+        ofstream file(temporary.c_str(),ios::out|ios::binary) ;
+
+        // If file is not opened
+        if ( ! file )
+        {
+            throw runtime_error("Cannot save the gallery in " + rFilename) ;
+        }
+
+        // Position of the records and of the identity table
+        int n_rows = mSize ? mFormat.getHeight() : 0 ;
+        int64_t records_offset = ( 64 + 4 * n_rows + 63 ) / 64 * 64 ;
+        int64_t ids_offset = records_offset + (int64_t)mSize * mRecordSize * 8 ;
+
+        // Header
+        char header[64] ;
+        memset(header,0,sizeof(header)) ;
+        int32_t sizes[7] = { 1 ,
+                             mSize ? mFormat.getWidth() : 0 ,
+                             n_rows ,
+                             mSize ? mFormat.getNumberOfFilters() : 0 ,
+                             mSize ? mFormat.getNumberOfWords() : 0 ,
+                             (int32_t)(mRecordSize * 8) ,
+                             mSize } ;
+        memcpy(header,"OSIG",4) ;
+        memcpy(header+4,sizes,sizeof(sizes)) ;
+        memcpy(header+32,&records_offset,8) ;
+        memcpy(header+40,&ids_offset,8) ;
+        file.write(header,sizeof(header)) ;
+
+        // Kept rows, padded up to the records
+        for ( int r = 0 ; r < n_rows ; r++ )
+        {
+            int32_t row = mFormat.getRowIndex(r) ;
+            file.write((const char*)&row,sizeof(row)) ;
+        }
+        vector<char> padding(records_offset-64-4*n_rows,0) ;
+        if ( ! padding.empty() )
+        {
+            file.write(&padding[0],padding.size()) ;
+        }
+
+        // Records
+        for ( int i = 0 ; i < mSize ; i++ )
+        {
+            file.write((const char*)getRecord(i),mRecordSize*8) ;
+        }
+
+        // Identity table : offsets, then characters
+        uint64_t offset = 0 ;
+        file.write((const char*)&offset,sizeof(offset)) ;
+        for ( int i = 0 ; i < mSize ; i++ )
+        {
+            offset += getId(i).size() ;
+            file.write((const char*)&offset,sizeof(offset)) ;
+        }
+        for ( int i = 0 ; i < mSize ; i++ )
+        {
+            string id = getId(i) ;
+            file.write(id.data(),id.size()) ;
+        }
+
+        if ( ! file )
+        {
+            throw runtime_error("Error while saving gallery in " + rFilename) ;
+        }
+
+        // Close the file, and replace the destination
+        file.close() ;
+        remove(rFilename.c_str()) ;
+        if ( rename(temporary.c_str(),rFilename.c_str()) != 0 )
+        {
+            throw runtime_error("Cannot save the gallery in " + rFilename) ;
+        }
+    }
+
+
+
+    void OsiGallery::load ( const string & rFilename )
+    {
+        clear() ;
+        mFile.open(rFilename) ;
+
+        const char * p_data = mFile.getData() ;
+        size_t size = mFile.getSize() ;
+
+        // Header
+        if ( size < 64 || memcmp(p_data,"OSIG",4) )
+        {
+            clear() ;
+            throw runtime_error("Invalid gallery in " + rFilename) ;
+        }
+        int32_t sizes[7] ;
+        int64_t records_offset , ids_offset ;
+        memcpy(sizes,p_data+4,sizeof(sizes)) ;
+        memcpy(&records_offset,p_data+32,8) ;
+        memcpy(&ids_offset,p_data+40,8) ;
+
+        int width = sizes[1] ;
+        int n_rows = sizes[2] ;
+        int n_filters = sizes[3] ;
+        int n_entries = sizes[6] ;
+        mRecordSize = sizes[5] / 8 ;
+
+        // Check that all parts fit in the file
+        bool valid = ( sizes[0] == 1 && n_entries >= 0 && n_rows >= 0 && sizes[5] >= 0 && sizes[5] % 8 == 0 &&
+                       records_offset % 8 == 0 && records_offset >= 64 + 4 * (int64_t)n_rows &&
+                       ids_offset == records_offset + (int64_t)n_entries * sizes[5] &&
+                       (uint64_t)ids_offset + 8 * ( (uint64_t)n_entries + 1 ) <= size ) ;
+        if ( valid && n_entries )
+        {
+            // The format is created only from a header of consistent sizes
+            valid = ( width > 0 && n_rows > 0 && n_filters > 0 && sizes[4] == ( (int64_t)width + 63 ) / 64 &&
+                      ( (int64_t)n_filters + 1 ) * n_rows * sizes[4] <= (int64_t)mRecordSize ) ;
+            if ( valid )
+            {
+                vector<int> rows(n_rows) ;
+                memcpy(&rows[0],p_data+64,4*n_rows) ;
+                mFormat.create(width,rows,n_filters) ;
+            }
+        }
+        if ( valid )
+        {
+            mpMappedRecords = (const uint64_t*)(p_data+records_offset) ;
+            mpMappedIdOffsets = (const uint64_t*)(p_data+ids_offset) ;
+            mpMappedIds = p_data + ids_offset + 8 * ( n_entries + 1 ) ;
+            valid = ( mpMappedIdOffsets[n_entries] <= size - ( mpMappedIds - p_data ) ) ;
+            for ( int i = 0 ; i < n_entries && valid ; i++ )
+            {
+                valid = ( mpMappedIdOffsets[i] <= mpMappedIdOffsets[i+1] ) ;
+            }
+        }
+        if ( ! valid )
+        {
+            clear() ;
+            throw runtime_error("Invalid gallery in " + rFilename) ;
+        }
+
+        mSize = n_entries ;
+    }
+
+
+
+
+
+    ///////////////////////////////////
+    // PRIVATE METHODS
+    ///////////////////////////////////
+
+
+    // Get the record of an entry, in memory or in the mapped file
+    const uint64_t * OsiGallery::getRecord ( int index ) const
+    {
+        if ( mFile.isOpened() )
+        {
+            return mpMappedRecords + (size_t)index * mRecordSize ;
+        }
+        return &mRecords[(size_t)index*mRecordSize] ;
+    }
+
+
+
+    // Match batches of probes against all entries, on a band of code planes
+    vector< vector<OsiCandidate> > OsiGallery::identify ( const vector<OsiIrisCode> & rProbes , int nCandidates , int nThreads , int batchSize , int firstFilter , int nFilters , float limit ) const
+    {
+        vector< vector<OsiCandidate> > candidates(rProbes.size()) ;
+        if ( nCandidates <= 0 || ! mSize )
+        {
+            return candidates ;
+        }
+        for ( int p = 0 ; p < rProbes.size() ; p++ )
+        {
+            checkProbe(rProbes[p]) ;
+        }
+        if ( batchSize <= 0 )
+        {
+            batchSize = max((int)rProbes.size(),1) ;
+        }
+        if ( nThreads <= 0 )
+        {
+            nThreads = max((int)thread::hardware_concurrency(),1) ;
+        }
+
+        // One scan of the gallery for each batch of probes
+        for ( int first = 0 ; first < rProbes.size() ; first += batchSize )
+        {
+            // The shifted versions of the probes are built once for all templates
+            int last = min(first+batchSize,(int)rProbes.size()) ;
+            vector<OsiProbe> probes ;
+            for ( int p = first ; p < last ; p++ )
+            {
+                probes.push_back(OsiProbe(rProbes[p])) ;
+            }
+
+            vector< vector<OsiCandidate> > batch_candidates ;
+            scan(probes,nCandidates,nThreads,firstFilter,nFilters,limit,batch_candidates) ;
+            for ( int p = first ; p < last ; p++ )
+            {
+                candidates[p].swap(batch_candidates[p-first]) ;
+            }
+        }
+
+        return candidates ;
+    }
+
+
+
+    // Match a batch of probes against all entries, chunk by chunk : a chunk is loaded
+    // from memory once, then stays in cache while it is compared to all probes
+    void OsiGallery::scan ( const vector<OsiProbe> & rProbes , int nCandidates , int nThreads , int firstFilter , int nFilters , float limit , vector< vector<OsiCandidate> > & rCandidates ) const
+    {
+        // The gallery is cut into chunks, and the chunks into one shard per thread
+        int n_probes = rProbes.size() ;
+        int n_chunks = ( mSize + OSI_GALLERY_CHUNK - 1 ) / OSI_GALLERY_CHUNK ;
+        nThreads = max(min(nThreads,n_chunks),1) ;
+        vector< atomic<int> > next_chunk(nThreads) ;
+        vector<int> last_chunk(nThreads) ;
+        for ( int t = 0 ; t < nThreads ; t++ )
+        {
+            next_chunk[t] = (int)( (int64_t)n_chunks * t / nThreads ) ;
+            last_chunk[t] = (int)( (int64_t)n_chunks * (t+1) / nThreads ) ;
+        }
+
+        // Each thread scans its shard, then steals the remaining chunks of the other shards.
+        // It keeps its own best candidates for each probe
+        vector< vector< vector<OsiCandidate> > > heaps(nThreads,vector< vector<OsiCandidate> >(n_probes)) ;
+        auto scan_chunks = [&]( int t )
+        {
+            for ( int v = 0 ; v < nThreads ; v++ )
+            {
+                int s = ( t + v ) % nThreads ;
+                for ( int c = next_chunk[s]++ ; c < last_chunk[s] ; c = next_chunk[s]++ )
+                {
+                    int last = min((c+1)*OSI_GALLERY_CHUNK,mSize) ;
+                    for ( int p = 0 ; p < n_probes ; p++ )
+                    {
+                        for ( int i = c * OSI_GALLERY_CHUNK ; i < last ; i++ )
+                        {
+                            rankEntry(rProbes[p],i,nCandidates,firstFilter,nFilters,limit,heaps[t][p]) ;
+                        }
+                    }
+                }
+            }
+        } ;
+        vector<thread> workers ;
+        for ( int t = 1 ; t < nThreads ; t++ )
+        {
+            workers.push_back(thread(scan_chunks,t)) ;
+        }
+        scan_chunks(0) ;
+        for ( int t = 0 ; t < workers.size() ; t++ )
+        {
+            workers[t].join() ;
+        }
+
+        // Merge : the order of candidates is total (score, then index), so the result
+        // does not depend on the number of threads
+        rCandidates.assign(n_probes,vector<OsiCandidate>()) ;
+        for ( int p = 0 ; p < n_probes ; p++ )
+        {
+            for ( int t = 0 ; t < nThreads ; t++ )
+            {
+                rCandidates[p].insert(rCandidates[p].end(),heaps[t][p].begin(),heaps[t][p].end()) ;
+            }
+            sort(rCandidates[p].begin(),rCandidates[p].end()) ;
+            if ( rCandidates[p].size() > nCandidates )
+            {
+                rCandidates[p].resize(nCandidates) ;
+            }
+        }
+    }
+
+
+
+    // Match an entry and keep it if it is among the best candidates
+    void OsiGallery::rankEntry ( const OsiProbe & rProbe , int index , int nCandidates , int firstFilter , int nFilters , float limit , vector<OsiCandidate> & rCandidates ) const
+    {
+        // Keep the best candidates in a max-heap : the worst kept candidate is on top
+        if ( rCandidates.size() < nCandidates && limit >= 1 )
+        {
+            rCandidates.push_back(OsiCandidate(index,rProbe.match(getRecord(index),firstFilter,nFilters))) ;
+            push_heap(rCandidates.begin(),rCandidates.end()) ;
+            return ;
+        }
+
+        // Otherwise, a template is kept only if its score is below the limit and, once the heap
+        // is full, ranked before the worst kept one : the matching can stop early. The threshold
+        // lets the scores equal to the worst one through, they are ranked by index like in the
+        // heap and in the merge, so that the result does not depend on the order of the entries
+        bool full = ( rCandidates.size() >= nCandidates ) ;
+        float threshold = full ? min(limit,nextafter(rCandidates.front().mScore,2.f)) : limit ;
+        float score ;
+        if ( rProbe.verify(getRecord(index),firstFilter,nFilters,threshold,score) )
+        {
+            if ( full )
+            {
+                if ( ! ( OsiCandidate(index,score) < rCandidates.front() ) )
+                {
+                    return ;
+                }
+                pop_heap(rCandidates.begin(),rCandidates.end()) ;
+                rCandidates.pop_back() ;
+            }
+            rCandidates.push_back(OsiCandidate(index,score)) ;
+            push_heap(rCandidates.begin(),rCandidates.end()) ;
+        }
+    }
+
+
+
+    // Check the identity of an entry without copying it
+    bool OsiGallery::hasId ( int index , const string & rId ) const
+    {
+        if ( mFile.isOpened() )
+        {
+            uint64_t length = mpMappedIdOffsets[index+1] - mpMappedIdOffsets[index] ;
+            return length == rId.size() && ! memcmp(mpMappedIds+mpMappedIdOffsets[index],rId.data(),length) ;
+        }
+        return mIds[index] == rId ;
+    }
+
+
+
+    // Check that a probe can be matched against the entries
+    void OsiGallery::checkProbe ( const OsiIrisCode & rProbe ) const
+    {
+        if ( rProbe.isEmpty() )
+        {
+            throw runtime_error("Cannot search the gallery because the template of the probe is not built") ;
+        }
+        if ( ! mFormat.isCompatible(rProbe) )
+        {
+            throw runtime_error("Cannot search the gallery because the template of the probe does not have the size of the gallery") ;
+        }
+    }
+
+
+
+    // Copy the mapped entries into memory, and unmap the file
+    void OsiGallery::copyMappedEntries ( )
+    {
+        mRecords.assign(mpMappedRecords,mpMappedRecords+(size_t)mSize*mRecordSize) ;
+        mIds.resize(mSize) ;
+        for ( int i = 0 ; i < mSize ; i++ )
+        {
+            mIds[i] = getId(i) ;
+        }
+
+        mFile.close() ;
+        mpMappedRecords = 0 ;
+        mpMappedIdOffsets = 0 ;
+        mpMappedIds = 0 ;
+    }
+
+} // end of namespace
+
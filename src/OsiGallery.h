@@ -0,0 +1,333 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_GALLERY_H
+#define OSI_GALLERY_H
+
+#include <string>
+#include <vector>
+#include "OsiIrisCode.h"
+#include "OsiMappedFile.h"
+
+// Number of entries scanned at once by a thread during identification (small enough to stay in cache)
+#define OSI_GALLERY_CHUNK 64
+
+// Default number of probes compared to a chunk of the gallery before the next chunk
+#define OSI_GALLERY_BATCH 16
+
+namespace osiris
+{
+
+    class OsiProbe ;
+
+    /** A candidate returned by identification.
+    * @see OsiGallery::identify()
+    */
+    class OsiCandidate
+    {
+
+    public :
+
+        /** Default constructor. */
+        OsiCandidate ( ) : mIndex(-1) , mScore(1) { }
+
+        /** Overloaded constructor.
+        * @param index Index of the entry in the gallery
+        * @param score Matching score with the probe
+        */
+        OsiCandidate ( int index , float score ) : mIndex(index) , mScore(score) { }
+
+        /** Order candidates by increasing score, then by increasing index.
+        * @param rCandidate The other candidate
+        * @return true if this candidate is ranked before the other one
+        */
+        bool operator < ( const OsiCandidate & rCandidate ) const
+        {
+            return mScore < rCandidate.mScore || ( mScore == rCandidate.mScore && mIndex < rCandidate.mIndex ) ;
+        }
+
+        /** Index of the entry in the gallery. */
+        int mIndex ;
+
+        /** Matching score between 0 (completely similar) and 1 (completely different). */
+        float mScore ;
+
+    } ; // End of class
+
+
+
+    /** Parameters of a coarse-to-fine identification.
+    * The probe is first matched against all entries on a band of code planes only, for all shifts :
+    * the entries whose score on the band is not below the rejection threshold are rejected, and the
+    * best ones are kept. Only these survivors are matched on all code planes.
+    * @see OsiGallery::identify()
+    */
+    class OsiCascade
+    {
+
+    public :
+
+        /** Default constructor : the two planes of the first filter, about a third of the matching work. */
+        OsiCascade ( ) : mFirstFilter(0) , mNumberOfFilters(2) , mRejectionThreshold(0.42f) , mNumberOfSurvivors(200) { }
+
+        /** Overloaded constructor.
+        * @param firstFilter First code plane of the band
+        * @param nFilters Number of code planes of the band
+        * @param rejectionThreshold Entries scoring this or more on the band are rejected (1 : none)
+        * @param nSurvivors Maximum number of entries matched on all code planes
+        */
+        OsiCascade ( int firstFilter , int nFilters , float rejectionThreshold , int nSurvivors ) :
+            mFirstFilter(firstFilter) , mNumberOfFilters(nFilters) ,
+            mRejectionThreshold(rejectionThreshold) , mNumberOfSurvivors(nSurvivors) { }
+
+        /** First code plane of the band. */
+        int mFirstFilter ;
+
+        /** Number of code planes of the band. */
+        int mNumberOfFilters ;
+
+        /** Entries scoring this or more on the band are rejected. */
+        float mRejectionThreshold ;
+
+        /** Maximum number of entries matched on all code planes. */
+        int mNumberOfSurvivors ;
+
+    } ; // End of class
+
+
+
+    /** Gallery of enrolled eyes.
+    * Keep the templates of all enrolled eyes in memory,
+    * and search the closest ones to a probe (1:N identification).\n
+    * All templates have the same size : they are stored as fixed-size records of
+    * 64-bit words (the words of OsiIrisCode::getData(), padded to 64 bytes).
+    * The gallery can be saved into a single file, then mapped in memory by load() :
+    * the records are scanned directly in the file, without parsing nor copying.
+    * @see OsiIrisCode , OsiManager
+    */
+    class OsiGallery
+    {
+
+    public :
+
+        /** Default constructor. Build an empty gallery. */
+        OsiGallery ( ) ;
+
+        /** Default destructor. */
+        ~OsiGallery ( ) ;
+
+        /** Enroll an eye.
+        * If the gallery is mapped from a file, it is first copied into memory.
+        * @param rId The identity of the eye
+        * @param rCode The template of the eye
+        * @return The index of the new entry
+        */
+        int enroll ( const std::string & rId , const OsiIrisCode & rCode ) ;
+
+        /** Remove all entries.
+        * @return void
+        */
+        void clear ( ) ;
+
+        /** Get the number of entries.
+        * @return The gallery size
+        */
+        int getSize ( ) const ;
+
+        /** Get the identity of an entry.
+        * @param index The index of the entry
+        * @return The identity given at enrollment
+        */
+        std::string getId ( int index ) const ;
+
+        /** Get the template of an entry.
+        * @param index The index of the entry
+        * @return A copy of the template given at enrollment
+        */
+        OsiIrisCode getTemplate ( int index ) const ;
+
+        /** Search the closest entries to a probe.
+        * The probe is matched against every entry with OsiIrisCode::match().
+        * The gallery is cut into chunks of OSI_GALLERY_CHUNK entries, shared among the threads :
+        * each thread scans its own range of chunks, then takes the chunks left by the others.
+        * The result does not depend on the number of threads.
+        * @param rProbe The template of the probe
+        * @param nCandidates The maximum number of candidates to return
+        * @param nThreads The number of threads, 0 for all available cores
+        * @return The best candidates, sorted by increasing score
+        */
+        std::vector<OsiCandidate> identify ( const OsiIrisCode & rProbe , int nCandidates , int nThreads = 1 ) const ;
+
+        /** Search the closest entries to several probes.
+        * The probes are processed by batches : each chunk of the gallery is compared to all probes
+        * of a batch while it is in cache, so the gallery is read from memory once per batch instead
+        * of once per probe. The results are the same as identify() for each probe.
+        * @param rProbes The templates of the probes
+        * @param nCandidates The maximum number of candidates to return for each probe
+        * @param nThreads The number of threads, 0 for all available cores
+        * @param batchSize The maximum number of probes of a batch, 0 for all probes at once
+        * @return The best candidates of each probe, sorted by increasing score
+        */
+        std::vector< std::vector<OsiCandidate> > identify ( const std::vector<OsiIrisCode> & rProbes , int nCandidates , int nThreads = 1 , int batchSize = OSI_GALLERY_BATCH ) const ;
+
+        /** Search the closest entries to a probe, coarse to fine.
+        * The gallery is scanned on the band of the cascade only, like identify(), then the survivors are
+        * matched on all code planes. The scores are exact, but a close entry may be missed if it
+        * is rejected on the band.
+        * @param rProbe The template of the probe
+        * @param nCandidates The maximum number of candidates to return
+        * @param rCascade The band and the cut-offs of the first stage
+        * @param nThreads The number of threads, 0 for all available cores
+        * @return The best candidates among the survivors, sorted by increasing score
+        */
+        std::vector<OsiCandidate> identify ( const OsiIrisCode & rProbe , int nCandidates , const OsiCascade & rCascade , int nThreads = 1 ) const ;
+
+        /** Search the closest entries to several probes, coarse to fine.
+        * The first stage processes the probes by batches, like identify().
+        * @param rProbes The templates of the probes
+        * @param nCandidates The maximum number of candidates to return for each probe
+        * @param rCascade The band and the cut-offs of the first stage
+        * @param nThreads The number of threads, 0 for all available cores
+        * @param batchSize The maximum number of probes of a batch, 0 for all probes at once
+        * @return The best candidates of each probe among its survivors, sorted by increasing score
+        */
+        std::vector< std::vector<OsiCandidate> > identify ( const std::vector<OsiIrisCode> & rProbes , int nCandidates , const OsiCascade & rCascade , int nThreads = 1 , int batchSize = OSI_GALLERY_BATCH ) const ;
+
+        /** Search the closest entries to a probe among some entries only.
+        * @param rProbe The template of the probe
+        * @param nCandidates The maximum number of candidates to return
+        * @param rEntries The indices of the entries to be matched
+        * @return The best candidates, sorted by increasing score
+        * @see OsiGalleryIndex
+        */
+        std::vector<OsiCandidate> identify ( const OsiIrisCode & rProbe , int nCandidates , const std::vector<int> & rEntries ) const ;
+
+        /** Verify a claimed identity (1:1 verification).
+        * The probe is matched against all entries enrolled with this identity,
+        * with early termination against the threshold (see OsiIrisCode::verify()).
+        * @param rId The claimed identity
+        * @param rProbe The template of the probe
+        * @param threshold The decision threshold
+        * @param rScore The best score. Exact if accepted, else a lower bound (not below the threshold)
+        * @return true if the score is below the threshold (accepted)
+        */
+        bool verify ( const std::string & rId , const OsiIrisCode & rProbe , float threshold , float & rScore ) const ;
+
+        /** Save the gallery into a binary file.
+        * The file contains a header of 64 bytes ("OSIG", version, width, number of kept rows,
+        * number of filters, words per row, record size in bytes, number of entries as 32-bit integers,
+        * then the offsets of records and identities as 64-bit integers), the kept rows as 32-bit integers,
+        * the records aligned on 64 bytes, and the identity table (offsets of the identities
+        * as 64-bit integers, then their characters).
+        * Values are written with the byte order of the machine.
+        * The file is written under a temporary name then renamed, so a mapped gallery can be saved in its own file.
+        * @param rFilename Complete path of the file
+        * @return void
+        * @see load()
+        */
+        void save ( const std::string & rFilename ) const ;
+
+        /** Map a gallery file in memory, replacing all entries.
+        * @param rFilename Complete path of the file
+        * @return void
+        * @see save()
+        */
+        void load ( const std::string & rFilename ) ;
+
+    private :
+
+        /** A template of the size of all entries (bits are not used). */
+        OsiIrisCode mFormat ;
+
+        /** Number of words per record. */
+        size_t mRecordSize ;
+
+        /** Number of entries. */
+        int mSize ;
+
+        /** Records of the entries, when they are in memory. */
+        std::vector<uint64_t> mRecords ;
+
+        /** Identities of the entries, when they are in memory. */
+        std::vector<std::string> mIds ;
+
+        /** The gallery file, when entries are mapped. */
+        OsiMappedFile mFile ;
+
+        /** Records and identity table in the mapped file. */
+        const uint64_t * mpMappedRecords ;
+        const uint64_t * mpMappedIdOffsets ;
+        const char * mpMappedIds ;
+
+        /** Get the record of an entry.
+        * @param index The index of the entry
+        * @return A pointer on the first word of the record
+        */
+        const uint64_t * getRecord ( int index ) const ;
+
+        /** Match batches of probes against all entries, on a band of code planes, with several threads.
+        * @param rProbes The templates of the probes
+        * @param nCandidates The maximum number of candidates for each probe
+        * @param nThreads The number of threads, 0 for all available cores
+        * @param batchSize The maximum number of probes of a batch, 0 for all probes at once
+        * @param firstFilter The first code plane of the band
+        * @param nFilters The number of code planes of the band
+        * @param limit Entries scoring this or more are not kept (1 : all entries can be kept)
+        * @return The best candidates of each probe, sorted by increasing score
+        */
+        std::vector< std::vector<OsiCandidate> > identify ( const std::vector<OsiIrisCode> & rProbes , int nCandidates , int nThreads , int batchSize , int firstFilter , int nFilters , float limit ) const ;
+
+        /** Match a batch of probes against all entries, with several threads.
+        * @param rProbes The probes
+        * @param nCandidates The maximum number of candidates for each probe
+        * @param nThreads The number of threads
+        * @param firstFilter The first code plane of the band
+        * @param nFilters The number of code planes of the band
+        * @param limit Entries scoring this or more are not kept (1 : all entries can be kept)
+        * @param rCandidates The best candidates of each probe, sorted by increasing score. Filled by the function
+        * @return void
+        */
+        void scan ( const std::vector<OsiProbe> & rProbes , int nCandidates , int nThreads , int firstFilter , int nFilters , float limit , std::vector< std::vector<OsiCandidate> > & rCandidates ) const ;
+
+        /** Match an entry against the probe and keep it if it is among the best candidates.
+        * @param rProbe The probe
+        * @param index The index of the entry
+        * @param nCandidates The maximum number of candidates
+        * @param firstFilter The first code plane of the band
+        * @param nFilters The number of code planes of the band
+        * @param limit Entries scoring this or more are not kept (1 : all entries can be kept)
+        * @param rCandidates The best candidates in a max-heap. Updated by the function
+        * @return void
+        */
+        void rankEntry ( const OsiProbe & rProbe , int index , int nCandidates , int firstFilter , int nFilters , float limit , std::vector<OsiCandidate> & rCandidates ) const ;
+
+        /** Check the identity of an entry without copying it.
+        * @param index The index of the entry
+        * @param rId The identity
+        * @return true if the entry has this identity
+        */
+        bool hasId ( int index , const std::string & rId ) const ;
+
+        /** Check that a probe can be matched against the entries.
+        * @param rProbe The template of the probe
+        * @return void
+        */
+        void checkProbe ( const OsiIrisCode & rProbe ) const ;
+
+        /** Copy the mapped entries into memory, and unmap the file.
+        * @return void
+        */
+        void copyMappedEntries ( ) ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
@@ -0,0 +1,267 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+#include "OsiGalleryIndex.h"
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // Number of bits of each substring
+    static const int KEY_BITS = 16 ;
+
+    // Number of keys of each table
+    static const int KEY_COUNT = 1 << KEY_BITS ;
+
+
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiGalleryIndex::OsiGalleryIndex ( )
+    {
+        mSize = 0 ;
+        mMaxShift = OSI_MAX_SHIFT ;
+        setParameters(2,4) ;
+    }
+
+    OsiGalleryIndex::~OsiGalleryIndex ( )
+    {
+        // Do nothing
+    }
+
+
+
+
+
+    // OPERATORS
+    ////////////
+
+    void OsiGalleryIndex::setParameters ( int radius , int minVotes )
+    {
+        if ( radius < 0 || radius > 3 )
+        {
+            throw runtime_error("The radius of the index search must be between 0 and 3") ;
+        }
+        mRadius = radius ;
+        mMinVotes = max(minVotes,1) ;
+
+        // All differences of at most radius bits
+        mNeighbours.clear() ;
+        for ( int k = 0 ; k < KEY_COUNT ; k++ )
+        {
+            if ( OsiIrisCode::countBits(k) <= mRadius )
+            {
+                mNeighbours.push_back(k) ;
+            }
+        }
+    }
+
+
+
+    void OsiGalleryIndex::build ( const OsiGallery & rGallery , const vector<uint64_t> & rPoints , int maxShift )
+    {
+        mSize = rGallery.getSize() ;
+        mMaxShift = maxShift ;
+        mPoints.clear() ;
+        mPositions.clear() ;
+        mOffsets.clear() ;
+        mEntries.clear() ;
+        if ( ! mSize )
+        {
+            return ;
+        }
+
+        // The rows of the templates are rows of the normalized iris
+        mPoints = rGallery.getTemplate(0) ;
+        int words = mPoints.getNumberOfWords() ;
+        for ( int r = 0 ; r < mPoints.getHeight() ; r++ )
+        {
+            if ( (size_t)( mPoints.getRowIndex(r) + 1 ) * words > rPoints.size() )
+            {
+                mSize = 0 ;
+                throw runtime_error("Cannot build the index because the application points do not match the size of the templates") ;
+            }
+            const uint64_t * p_row = &rPoints[mPoints.getRowIndex(r)*words] ;
+            for ( int c = 0 ; c < mPoints.getWidth() ; c++ )
+            {
+                if ( ( p_row[c/64] >> (c%64) ) & 1 )
+                {
+                    mPositions.push_back(make_pair(r,c)) ;
+                }
+            }
+        }
+        if ( mPositions.empty() )
+        {
+            mSize = 0 ;
+            throw runtime_error("Cannot build the index because there is no application point") ;
+        }
+
+        // Keys of all entries
+        int n_tables = ( mPositions.size() * mPoints.getNumberOfFilters() + KEY_BITS - 1 ) / KEY_BITS ;
+        vector<uint16_t> keys(n_tables*(size_t)mSize) ;
+        vector<uint16_t> entry_keys ;
+        for ( int i = 0 ; i < mSize ; i++ )
+        {
+            computeKeys(rGallery.getTemplate(i),0,entry_keys) ;
+            copy(entry_keys.begin(),entry_keys.end(),keys.begin()+(size_t)i*n_tables) ;
+        }
+
+        // Each table lists its entries sorted by key (counting sort)
+        mOffsets.resize(n_tables) ;
+        mEntries.resize(n_tables) ;
+        for ( int t = 0 ; t < n_tables ; t++ )
+        {
+            vector<uint32_t> & offsets = mOffsets[t] ;
+            offsets.assign(KEY_COUNT+1,0) ;
+            for ( int i = 0 ; i < mSize ; i++ )
+            {
+                offsets[keys[(size_t)i*n_tables+t]+1]++ ;
+            }
+            for ( int k = 0 ; k < KEY_COUNT ; k++ )
+            {
+                offsets[k+1] += offsets[k] ;
+            }
+
+            vector<uint32_t> next(offsets.begin(),offsets.end()-1) ;
+            mEntries[t].resize(mSize) ;
+            for ( int i = 0 ; i < mSize ; i++ )
+            {
+                mEntries[t][next[keys[(size_t)i*n_tables+t]]++] = i ;
+            }
+        }
+    }
+
+
+
+    int OsiGalleryIndex::getSize ( ) const
+    {
+        return mSize ;
+    }
+
+
+
+
+
+    // Functions for searching
+    //////////////////////////
+
+    vector<int> OsiGalleryIndex::search ( const OsiGallery & rGallery , const OsiIrisCode & rProbe ) const
+    {
+        vector<int> candidates ;
+        if ( mSize && ( rProbe.isEmpty() || ! mPoints.isCompatible(rProbe) ) )
+        {
+            throw runtime_error("Cannot search the index because the template of the probe does not have the size of the gallery") ;
+        }
+
+        // Votes of the entries for one shift, and entries having votes
+        vector<uint8_t> votes(mSize,0) ;
+        vector<uint8_t> selected(mSize,0) ;
+        vector<int> voters ;
+        vector<uint16_t> keys ;
+
+        for ( int s = -mMaxShift ; s <= mMaxShift ; s++ )
+        {
+            computeKeys(rProbe,s,keys) ;
+
+            // Look up each table for the keys within the radius
+            for ( int t = 0 ; t < keys.size() ; t++ )
+            {
+                const vector<uint32_t> & offsets = mOffsets[t] ;
+                const vector<uint32_t> & entries = mEntries[t] ;
+                for ( int n = 0 ; n < mNeighbours.size() ; n++ )
+                {
+                    int key = keys[t] ^ mNeighbours[n] ;
+                    for ( uint32_t e = offsets[key] ; e < offsets[key+1] ; e++ )
+                    {
+                        int i = entries[e] ;
+                        if ( ! votes[i] )
+                        {
+                            voters.push_back(i) ;
+                        }
+                        if ( votes[i] < 255 )
+                        {
+                            votes[i]++ ;
+                        }
+                    }
+                }
+            }
+
+            // Select the entries with enough votes, then reset the votes
+            for ( int v = 0 ; v < voters.size() ; v++ )
+            {
+                if ( votes[voters[v]] >= mMinVotes )
+                {
+                    selected[voters[v]] = 1 ;
+                }
+                votes[voters[v]] = 0 ;
+            }
+            voters.clear() ;
+        }
+
+        for ( int i = 0 ; i < mSize ; i++ )
+        {
+            if ( selected[i] )
+            {
+                candidates.push_back(i) ;
+            }
+        }
+
+        // Entries enrolled after the index was built
+        for ( int i = mSize ; i < rGallery.getSize() ; i++ )
+        {
+            candidates.push_back(i) ;
+        }
+
+        return candidates ;
+    }
+
+
+
+    vector<OsiCandidate> OsiGalleryIndex::identify ( const OsiGallery & rGallery , const OsiIrisCode & rProbe , int nCandidates ) const
+    {
+        return rGallery.identify(rProbe,nCandidates,search(rGallery,rProbe)) ;
+    }
+
+
+
+
+
+    ///////////////////////////////////
+    // PRIVATE METHODS
+    ///////////////////////////////////
+
+
+    // Cut the bits at the application points (all filters) into keys of 16 bits
+    void OsiGalleryIndex::computeKeys ( const OsiIrisCode & rCode , int shift , vector<uint16_t> & rKeys ) const
+    {
+        int n_filters = mPoints.getNumberOfFilters() ;
+        int width = mPoints.getWidth() ;
+        rKeys.assign( ( mPositions.size() * n_filters + KEY_BITS - 1 ) / KEY_BITS , 0 ) ;
+
+        // The bit of the point (r,c) in the shifted code is the bit (r,c+shift) of the code
+        int b = 0 ;
+        for ( int p = 0 ; p < mPositions.size() ; p++ )
+        {
+            int r = mPositions[p].first ;
+            int c = ( ( mPositions[p].second + shift ) % width + width ) % width ;
+            for ( int f = 0 ; f < n_filters ; f++ , b++ )
+            {
+                if ( rCode.getCodeBit(f,r,c) )
+                {
+                    rKeys[b/KEY_BITS] |= 1 << (b%KEY_BITS) ;
+                }
+            }
+        }
+    }
+
+} // end of namespace
+
@@ -0,0 +1,126 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_GALLERY_INDEX_H
+#define OSI_GALLERY_INDEX_H
+
+#include <utility>
+#include <vector>
+#include <stdint.h>
+#include "OsiGallery.h"
+
+namespace osiris
+{
+
+    /** Multi-index hashing of a gallery, for sub-linear identification.
+    * The code bits at the application points (all filters) of each template are cut into
+    * substrings of 16 bits, and each substring is indexed in its own table.\n
+    * To search a probe, each shift of the probe is cut the same way, and every table is
+    * looked up for the keys within a small hamming radius of the probe substring. An entry
+    * gets one vote per table where it is found. The entries reaching the minimum number of
+    * votes for at least one shift are the candidates : only them are matched with the
+    * shift-tolerant matching. The search is approximate : a genuine entry with too few
+    * similar substrings is missed.\n
+    * The entries enrolled after build() are not indexed : they are always matched.
+    * @see OsiGallery
+    */
+    class OsiGalleryIndex
+    {
+
+    public :
+
+        /** Default constructor. Build an empty index. */
+        OsiGalleryIndex ( ) ;
+
+        /** Default destructor. */
+        ~OsiGalleryIndex ( ) ;
+
+        /** Set the parameters of the search.
+        * @param radius The maximum number of different bits between two similar substrings (0 to 3)
+        * @param minVotes The minimum number of similar substrings for an entry to be matched
+        * @return void
+        */
+        void setParameters ( int radius , int minVotes ) ;
+
+        /** Index all entries of a gallery.
+        * Only the application points of the model are hashed : the other positions of the
+        * normalized iris are never used by the masks, their bits would only add noise to the keys.
+        * @param rGallery The gallery
+        * @param rPoints The application points of each row of the normalized iris, packed as the
+        * masks of OsiIrisCode : (width+63)/64 words per row, bit j%64 of word j/64 set at column j
+        * @param maxShift The maximum shift in columns tested during the search
+        * @return void
+        * @see OsiModelBundle::packPoints()
+        */
+        void build ( const OsiGallery & rGallery , const std::vector<uint64_t> & rPoints , int maxShift = OSI_MAX_SHIFT ) ;
+
+        /** Get the number of indexed entries.
+        * @return The number of entries
+        */
+        int getSize ( ) const ;
+
+        /** Get the entries to be matched against a probe.
+        * @param rGallery The gallery used to build the index
+        * @param rProbe The template of the probe
+        * @return The indices of the candidate entries, in increasing order
+        */
+        std::vector<int> search ( const OsiGallery & rGallery , const OsiIrisCode & rProbe ) const ;
+
+        /** Search the closest entries to a probe among the candidate entries.
+        * @param rGallery The gallery used to build the index
+        * @param rProbe The template of the probe
+        * @param nCandidates The maximum number of candidates to return
+        * @return The best candidates, sorted by increasing score
+        * @see search() , OsiGallery::identify()
+        */
+        std::vector<OsiCandidate> identify ( const OsiGallery & rGallery , const OsiIrisCode & rProbe , int nCandidates ) const ;
+
+    private :
+
+        /** Number of indexed entries. */
+        int mSize ;
+
+        /** Maximum shift in columns. */
+        int mMaxShift ;
+
+        /** Search radius in bits. */
+        int mRadius ;
+
+        /** Minimum number of votes. */
+        int mMinVotes ;
+
+        /** A template of the size of the entries. */
+        OsiIrisCode mPoints ;
+
+        /** Positions of the application points in the templates (row, column). */
+        std::vector< std::pair<int,int> > mPositions ;
+
+        /** For each table, first entry of each key (the entries of key k are from mOffsets[k] to mOffsets[k+1]). */
+        std::vector< std::vector<uint32_t> > mOffsets ;
+
+        /** For each table, the entries sorted by key. */
+        std::vector< std::vector<uint32_t> > mEntries ;
+
+        /** The differences between a key and the keys within the radius. */
+        std::vector<uint16_t> mNeighbours ;
+
+        /** Cut the bits of a code at the application points into keys.
+        * @param rCode The code
+        * @param shift The shift in columns of the code
+        * @param rKeys The keys, one per table. Filled by the function
+        * @return void
+        */
+        void computeKeys ( const OsiIrisCode & rCode , int shift , std::vector<uint16_t> & rKeys ) const ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
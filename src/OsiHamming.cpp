@@ -0,0 +1,416 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <stdexcept>
+#include <vector>
+#include "OsiHamming.h"
+#include "OsiIrisCode.h"
+
+// The vector kernels are compiled for x86-64 only. With GCC and Clang, each kernel is compiled
+// for its own instruction set (target attribute), so the rest of the binary runs everywhere
+#if defined(__GNUC__) && defined(__x86_64__)
+#define OSI_HAMMING_X86
+#define OSI_TARGET(isa) __attribute__((target(isa)))
+#include <cpuid.h>
+#include <immintrin.h>
+#if ( defined(__clang__) && __clang_major__ >= 6 ) || ( ! defined(__clang__) && __GNUC__ >= 8 )
+#define OSI_HAMMING_AVX512
+#endif
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define OSI_HAMMING_X86
+#define OSI_TARGET(isa)
+#include <intrin.h>
+#include <immintrin.h>
+#if _MSC_VER >= 1920
+#define OSI_HAMMING_AVX512
+#endif
+#endif
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // Signature of all kernels
+    typedef int (*CountFunction) ( const uint64_t * , size_t , const uint64_t * , size_t ,
+                                   const uint64_t * , const uint64_t * , int , int ) ;
+
+
+
+    // Portable kernel
+    static int countScalar ( const uint64_t * pCode1 , size_t stride1 ,
+                             const uint64_t * pCode2 , size_t stride2 ,
+                             const uint64_t * pMask1 , const uint64_t * pMask2 ,
+                             int nWords , int nPlanes )
+    {
+        int count = 0 ;
+        for ( int p = 0 ; p < nPlanes ; p++ )
+        {
+            const uint64_t * p_code1 = pCode1 + p * stride1 ;
+            const uint64_t * p_code2 = pCode2 + p * stride2 ;
+            for ( int w = 0 ; w < nWords ; w++ )
+            {
+                count += OsiIrisCode::countBits( ( p_code1[w] ^ p_code2[w] ) & pMask1[w] & pMask2[w] ) ;
+            }
+        }
+        return count ;
+    }
+
+
+
+#ifdef OSI_HAMMING_X86
+
+    // Kernel with the POPCNT instruction, one word at a time
+    OSI_TARGET("popcnt")
+    static int countPopcnt ( const uint64_t * pCode1 , size_t stride1 ,
+                             const uint64_t * pCode2 , size_t stride2 ,
+                             const uint64_t * pMask1 , const uint64_t * pMask2 ,
+                             int nWords , int nPlanes )
+    {
+        int64_t count = 0 ;
+        for ( int w = 0 ; w < nWords ; w++ )
+        {
+            uint64_t mask = pMask1[w] & pMask2[w] ;
+            for ( int p = 0 ; p < nPlanes ; p++ )
+            {
+                count += _mm_popcnt_u64( ( pCode1[p*stride1+w] ^ pCode2[p*stride2+w] ) & mask ) ;
+            }
+        }
+        return (int) count ;
+    }
+
+
+
+    // Kernel with AVX2, four words at a time : the bits of each byte are counted with
+    // a lookup table of the 16 nibbles, then the bytes are summed by groups of 8
+    OSI_TARGET("avx2")
+    static int countAvx2 ( const uint64_t * pCode1 , size_t stride1 ,
+                           const uint64_t * pCode2 , size_t stride2 ,
+                           const uint64_t * pMask1 , const uint64_t * pMask2 ,
+                           int nWords , int nPlanes )
+    {
+        const __m256i lookup = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                                                0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4) ;
+        const __m256i nibble = _mm256_set1_epi8(0x0F) ;
+        __m256i total = _mm256_setzero_si256() ;
+
+        int w = 0 ;
+        for ( ; w + 4 <= nWords ; w += 4 )
+        {
+            __m256i mask = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(pMask1+w)),
+                                            _mm256_loadu_si256((const __m256i*)(pMask2+w))) ;
+            for ( int p = 0 ; p < nPlanes ; p++ )
+            {
+                __m256i code1 = _mm256_loadu_si256((const __m256i*)(pCode1+p*stride1+w)) ;
+                __m256i code2 = _mm256_loadu_si256((const __m256i*)(pCode2+p*stride2+w)) ;
+                __m256i diff = _mm256_and_si256(_mm256_xor_si256(code1,code2),mask) ;
+                __m256i low = _mm256_shuffle_epi8(lookup,_mm256_and_si256(diff,nibble)) ;
+                __m256i high = _mm256_shuffle_epi8(lookup,_mm256_and_si256(_mm256_srli_epi16(diff,4),nibble)) ;
+                total = _mm256_add_epi64(total,_mm256_sad_epu8(_mm256_add_epi8(low,high),_mm256_setzero_si256())) ;
+            }
+        }
+
+        int64_t count = _mm256_extract_epi64(total,0) + _mm256_extract_epi64(total,1) +
+                        _mm256_extract_epi64(total,2) + _mm256_extract_epi64(total,3) ;
+
+        // Last words
+        for ( ; w < nWords ; w++ )
+        {
+            uint64_t mask = pMask1[w] & pMask2[w] ;
+            for ( int p = 0 ; p < nPlanes ; p++ )
+            {
+                count += _mm_popcnt_u64( ( pCode1[p*stride1+w] ^ pCode2[p*stride2+w] ) & mask ) ;
+            }
+        }
+
+        return (int) count ;
+    }
+
+#endif
+
+
+
+#ifdef OSI_HAMMING_AVX512
+
+    // Kernel with AVX-512 VPOPCNTDQ, eight words at a time (a row of 512 bits at once)
+    OSI_TARGET("avx512f,avx512vpopcntdq")
+    static int countAvx512 ( const uint64_t * pCode1 , size_t stride1 ,
+                             const uint64_t * pCode2 , size_t stride2 ,
+                             const uint64_t * pMask1 , const uint64_t * pMask2 ,
+                             int nWords , int nPlanes )
+    {
+        __m512i total = _mm512_setzero_si512() ;
+        for ( int w = 0 ; w < nWords ; w += 8 )
+        {
+            // The words after the end of the row are not loaded
+            __mmask8 valid = (__mmask8) ( nWords - w >= 8 ? 0xFF : ( 1 << ( nWords - w ) ) - 1 ) ;
+            __m512i mask = _mm512_and_si512(_mm512_maskz_loadu_epi64(valid,pMask1+w),
+                                            _mm512_maskz_loadu_epi64(valid,pMask2+w)) ;
+            for ( int p = 0 ; p < nPlanes ; p++ )
+            {
+                __m512i code1 = _mm512_maskz_loadu_epi64(valid,pCode1+p*stride1+w) ;
+                __m512i code2 = _mm512_maskz_loadu_epi64(valid,pCode2+p*stride2+w) ;
+                __m512i diff = _mm512_and_si512(_mm512_xor_si512(code1,code2),mask) ;
+                total = _mm512_add_epi64(total,_mm512_popcnt_epi64(diff)) ;
+            }
+        }
+        int64_t sums [8] ;
+        _mm512_storeu_si512(sums,total) ;
+        return (int) ( sums[0] + sums[1] + sums[2] + sums[3] + sums[4] + sums[5] + sums[6] + sums[7] ) ;
+    }
+
+#endif
+
+
+
+#ifdef OSI_HAMMING_X86
+
+    // Registers eax, ebx, ecx, edx of a CPUID leaf
+    static void readCpuid ( unsigned leaf , unsigned registers [4] )
+    {
+#if defined(_MSC_VER)
+        int values [4] ;
+        __cpuidex(values,leaf,0) ;
+        for ( int i = 0 ; i < 4 ; i++ )
+        {
+            registers[i] = values[i] ;
+        }
+#else
+        __cpuid_count(leaf,0,registers[0],registers[1],registers[2],registers[3]) ;
+#endif
+    }
+
+
+
+    // Register states saved by the system (XCR0)
+    static uint64_t readXcr0 ( )
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0) ;
+#else
+        unsigned low , high ;
+        __asm__ ( "xgetbv" : "=a" (low) , "=d" (high) : "c" (0) ) ;
+        return ( (uint64_t) high << 32 ) | low ;
+#endif
+    }
+
+#endif
+
+
+
+    // Ask the processor (and the system, for the wide registers) which kernels can run
+    static bool detectKernel ( OsiHamming::Kernel kernel )
+    {
+        if ( kernel == OsiHamming::SCALAR )
+        {
+            return true ;
+        }
+
+#ifdef OSI_HAMMING_X86
+        unsigned registers [4] ;
+        readCpuid(0,registers) ;
+        unsigned max_leaf = registers[0] ;
+
+        readCpuid(1,registers) ;
+        bool popcnt = ( registers[2] >> 23 ) & 1 ;
+        bool osxsave = ( registers[2] >> 27 ) & 1 ;
+        bool avx = ( registers[2] >> 28 ) & 1 ;
+        if ( kernel == OsiHamming::POPCNT )
+        {
+            return popcnt ;
+        }
+        if ( ! popcnt || ! osxsave || ! avx || max_leaf < 7 )
+        {
+            return false ;
+        }
+
+        uint64_t xcr0 = readXcr0() ;
+        readCpuid(7,registers) ;
+        if ( kernel == OsiHamming::AVX2 )
+        {
+            // The system must save the SSE and AVX registers
+            return ( ( xcr0 & 0x6 ) == 0x6 ) && ( ( registers[1] >> 5 ) & 1 ) ;
+        }
+#ifdef OSI_HAMMING_AVX512
+        if ( kernel == OsiHamming::AVX512 )
+        {
+            // The system must also save the opmask and ZMM registers
+            return ( ( xcr0 & 0xE6 ) == 0xE6 ) && ( ( registers[1] >> 16 ) & 1 ) && ( ( registers[2] >> 14 ) & 1 ) ;
+        }
+#endif
+#endif
+
+        return false ;
+    }
+
+
+
+    static CountFunction getFunction ( OsiHamming::Kernel kernel )
+    {
+        switch ( kernel )
+        {
+#ifdef OSI_HAMMING_X86
+            case OsiHamming::POPCNT : return countPopcnt ;
+            case OsiHamming::AVX2 : return countAvx2 ;
+#endif
+#ifdef OSI_HAMMING_AVX512
+            case OsiHamming::AVX512 : return countAvx512 ;
+#endif
+            default : return countScalar ;
+        }
+    }
+
+
+
+    // The widest supported kernel
+    static OsiHamming::Kernel findBestKernel ( )
+    {
+        OsiHamming::Kernel kernels [] = { OsiHamming::AVX512 , OsiHamming::AVX2 , OsiHamming::POPCNT } ;
+        for ( int k = 0 ; k < 3 ; k++ )
+        {
+            if ( detectKernel(kernels[k]) )
+            {
+                return kernels[k] ;
+            }
+        }
+        return OsiHamming::SCALAR ;
+    }
+
+
+
+    // The kernel is chosen when the program starts
+    static OsiHamming::Kernel sKernel = findBestKernel() ;
+    static CountFunction spCount = getFunction(sKernel) ;
+
+
+
+
+
+    // Functions for counting
+    /////////////////////////
+
+    int OsiHamming::countDifferences ( const uint64_t * pCode1 , size_t stride1 ,
+                                       const uint64_t * pCode2 , size_t stride2 ,
+                                       const uint64_t * pMask1 , const uint64_t * pMask2 ,
+                                       int nWords , int nPlanes )
+    {
+        return spCount(pCode1,stride1,pCode2,stride2,pMask1,pMask2,nWords,nPlanes) ;
+    }
+
+
+
+
+
+    // Functions for choosing the kernel
+    ////////////////////////////////////
+
+    bool OsiHamming::isSupported ( Kernel kernel )
+    {
+        return detectKernel(kernel) ;
+    }
+
+
+
+    OsiHamming::Kernel OsiHamming::getKernel ( )
+    {
+        return sKernel ;
+    }
+
+
+
+    void OsiHamming::setKernel ( Kernel kernel )
+    {
+        if ( ! isSupported(kernel) )
+        {
+            throw runtime_error("The " + getName(kernel) + " kernel is not supported by this processor") ;
+        }
+        sKernel = kernel ;
+        spCount = getFunction(kernel) ;
+    }
+
+
+
+    void OsiHamming::setKernel ( const string & rName )
+    {
+        if ( rName == "auto" || rName == "" )
+        {
+            setKernel(findBestKernel()) ;
+            return ;
+        }
+        Kernel kernels [] = { SCALAR , POPCNT , AVX2 , AVX512 } ;
+        for ( int k = 0 ; k < 4 ; k++ )
+        {
+            if ( rName == getName(kernels[k]) )
+            {
+                setKernel(kernels[k]) ;
+                return ;
+            }
+        }
+        throw runtime_error("Unknown kernel " + rName + " : use auto, scalar, popcnt, avx2 or avx512") ;
+    }
+
+
+
+    string OsiHamming::getName ( Kernel kernel )
+    {
+        switch ( kernel )
+        {
+            case POPCNT : return "popcnt" ;
+            case AVX2 : return "avx2" ;
+            case AVX512 : return "avx512" ;
+            default : return "scalar" ;
+        }
+    }
+
+
+
+    bool OsiHamming::checkKernels ( )
+    {
+        // Random words (linear congruential generator, so the check is reproducible)
+        const int n_words = 37 ;
+        const int n_planes = 3 ;
+        vector<uint64_t> words(2*n_planes*n_words+2*n_words) ;
+        uint64_t state = 0x2545F4914F6CDD1DULL ;
+        for ( int i = 0 ; i < words.size() ; i++ )
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL ;
+            words[i] = state ^ ( state >> 29 ) ;
+        }
+        const uint64_t * p_code1 = &words[0] ;
+        const uint64_t * p_code2 = p_code1 + n_planes * n_words ;
+        const uint64_t * p_mask1 = p_code2 + n_planes * n_words ;
+        const uint64_t * p_mask2 = p_mask1 + n_words ;
+
+        // All lengths, to go through the ends of the vector loops
+        Kernel kernels [] = { POPCNT , AVX2 , AVX512 } ;
+        for ( int k = 0 ; k < 3 ; k++ )
+        {
+            if ( ! isSupported(kernels[k]) )
+            {
+                continue ;
+            }
+            CountFunction p_count = getFunction(kernels[k]) ;
+            for ( int n = 0 ; n <= n_words ; n++ )
+            {
+                for ( int p = 1 ; p <= n_planes ; p++ )
+                {
+                    int offset = n_words - n ;
+                    if ( p_count(p_code1+offset,n_words,p_code2,n,p_mask1,p_mask2+offset,n,p) !=
+                         countScalar(p_code1+offset,n_words,p_code2,n,p_mask1,p_mask2+offset,n,p) )
+                    {
+                        return false ;
+                    }
+                }
+            }
+        }
+
+        return true ;
+    }
+
+} // end of namespace
+
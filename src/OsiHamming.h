@@ -0,0 +1,95 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_HAMMING_H
+#define OSI_HAMMING_H
+
+#include <cstddef>
+#include <string>
+#include <stdint.h>
+
+namespace osiris
+{
+
+    /** Kernels counting the different valid bits of packed iris codes.
+    * This is the inner loop of the matching : popcount((code1 ^ code2) & mask1 & mask2),
+    * summed over the words of a row and over the code planes (one per filter).\n
+    * Several implementations are compiled in the same binary : a portable one, one with the
+    * POPCNT instruction (SSE4.2), one with AVX2 and one with AVX-512 VPOPCNTDQ. The widest one
+    * supported by the processor and the system is chosen once, at start-up, from CPUID.
+    * All kernels give exactly the same counts.
+    * @see OsiIrisCode , OsiProbe
+    */
+    class OsiHamming
+    {
+
+    public :
+
+        /** The implementations, from the most portable to the widest. */
+        enum Kernel { SCALAR , POPCNT , AVX2 , AVX512 } ;
+
+        /** Count the different valid bits of several code planes.
+        * Plane p of the first code starts at pCode1 + p * stride1, and plane p of the second code
+        * at pCode2 + p * stride2. All planes share the same masks.
+        * @param pCode1 The first plane of the first code
+        * @param stride1 The number of words between two planes of the first code
+        * @param pCode2 The first plane of the second code
+        * @param stride2 The number of words between two planes of the second code
+        * @param pMask1 The mask of the first code
+        * @param pMask2 The mask of the second code
+        * @param nWords The number of words of each plane
+        * @param nPlanes The number of planes
+        * @return The number of bits on in (code1 ^ code2) & mask1 & mask2 , for all planes
+        */
+        static int countDifferences ( const uint64_t * pCode1 , size_t stride1 ,
+                                      const uint64_t * pCode2 , size_t stride2 ,
+                                      const uint64_t * pMask1 , const uint64_t * pMask2 ,
+                                      int nWords , int nPlanes ) ;
+
+        /** Check if a kernel can run on this processor.
+        * @param kernel The kernel
+        * @return true if the kernel is compiled in and supported by the processor and the system
+        */
+        static bool isSupported ( Kernel kernel ) ;
+
+        /** Get the kernel used by countDifferences().
+        * @return The kernel
+        */
+        static Kernel getKernel ( ) ;
+
+        /** Choose the kernel used by countDifferences().
+        * Must not be called while codes are being matched.
+        * @param kernel The kernel
+        * @return void
+        */
+        static void setKernel ( Kernel kernel ) ;
+
+        /** Choose the kernel used by countDifferences() from its name.
+        * @param rName "auto" for the widest supported kernel, or "scalar", "popcnt", "avx2", "avx512"
+        * @return void
+        */
+        static void setKernel ( const std::string & rName ) ;
+
+        /** Get the name of a kernel.
+        * @param kernel The kernel
+        * @return The name of the kernel
+        */
+        static std::string getName ( Kernel kernel ) ;
+
+        /** Compare all supported kernels to the portable one on random codes.
+        * @return true if all kernels give the same counts
+        */
+        static bool checkKernels ( ) ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
@@ -0,0 +1,536 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include "OsiHamming.h"
+#include "OsiIrisCode.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiIrisCode::OsiIrisCode ( )
+    {
+        mWidth = 0 ;
+        mHeight = 0 ;
+        mNumberOfFilters = 0 ;
+        mNumberOfWords = 0 ;
+    }
+
+    OsiIrisCode::~OsiIrisCode ( )
+    {
+        // Do nothing
+    }
+
+
+
+
+
+    // Functions for building the code
+    //////////////////////////////////
+
+    void OsiIrisCode::create ( int width , int height , int nFilters )
+    {
+        // Keep all rows
+        vector<int> rows(max(height,0)) ;
+        for ( int r = 0 ; r < rows.size() ; r++ )
+        {
+            rows[r] = r ;
+        }
+        create(width,rows,nFilters) ;
+    }
+
+
+
+    void OsiIrisCode::create ( int width , const vector<int> & rRows , int nFilters )
+    {
+        if ( width <= 0 || rRows.empty() || nFilters <= 0 )
+        {
+            throw runtime_error("Cannot create an iris code with a null size") ;
+        }
+
+        mWidth = width ;
+        mHeight = rRows.size() ;
+        mRows = rRows ;
+        mNumberOfFilters = nFilters ;
+        mNumberOfWords = ( width + 63 ) / 64 ;
+
+        // nFilters code planes + 1 mask plane, all bits off
+        mData.assign((nFilters+1)*mHeight*mNumberOfWords,0) ;
+    }
+
+
+
+    void OsiIrisCode::clear ( )
+    {
+        mWidth = 0 ;
+        mHeight = 0 ;
+        mRows.clear() ;
+        mNumberOfFilters = 0 ;
+        mNumberOfWords = 0 ;
+        mData.clear() ;
+    }
+
+
+
+    bool OsiIrisCode::isEmpty ( ) const
+    {
+        return mData.empty() ;
+    }
+
+
+
+    int OsiIrisCode::getWidth ( ) const
+    {
+        return mWidth ;
+    }
+
+
+
+    int OsiIrisCode::getHeight ( ) const
+    {
+        return mHeight ;
+    }
+
+
+
+    int OsiIrisCode::getRowIndex ( int row ) const
+    {
+        return mRows[row] ;
+    }
+
+
+
+    int OsiIrisCode::getNumberOfFilters ( ) const
+    {
+        return mNumberOfFilters ;
+    }
+
+
+
+    int OsiIrisCode::getNumberOfWords ( ) const
+    {
+        return mNumberOfWords ;
+    }
+
+
+
+    size_t OsiIrisCode::getSizeInBytes ( ) const
+    {
+        return sizeof(OsiIrisCode) + mData.size()*sizeof(uint64_t) + mRows.size()*sizeof(int) ;
+    }
+
+
+
+    uint64_t * OsiIrisCode::getCodeRow ( int filter , int row )
+    {
+        return &mData[(filter*mHeight+row)*mNumberOfWords] ;
+    }
+
+
+
+    const uint64_t * OsiIrisCode::getCodeRow ( int filter , int row ) const
+    {
+        return &mData[(filter*mHeight+row)*mNumberOfWords] ;
+    }
+
+
+
+    uint64_t * OsiIrisCode::getMaskRow ( int row )
+    {
+        return &mData[(mNumberOfFilters*mHeight+row)*mNumberOfWords] ;
+    }
+
+
+
+    const uint64_t * OsiIrisCode::getMaskRow ( int row ) const
+    {
+        return &mData[(mNumberOfFilters*mHeight+row)*mNumberOfWords] ;
+    }
+
+
+
+    uint64_t * OsiIrisCode::getData ( )
+    {
+        return &mData[0] ;
+    }
+
+
+
+    const uint64_t * OsiIrisCode::getData ( ) const
+    {
+        return &mData[0] ;
+    }
+
+
+
+    size_t OsiIrisCode::getDataSize ( ) const
+    {
+        return mData.size() ;
+    }
+
+
+
+    void OsiIrisCode::setCodeBit ( int filter , int row , int col , bool value )
+    {
+        uint64_t & word = getCodeRow(filter,row)[col/64] ;
+        uint64_t bit = (uint64_t)1 << (col%64) ;
+        word = value ? ( word | bit ) : ( word & ~bit ) ;
+    }
+
+
+
+    void OsiIrisCode::setMaskBit ( int row , int col , bool value )
+    {
+        uint64_t & word = getMaskRow(row)[col/64] ;
+        uint64_t bit = (uint64_t)1 << (col%64) ;
+        word = value ? ( word | bit ) : ( word & ~bit ) ;
+    }
+
+
+
+    bool OsiIrisCode::getCodeBit ( int filter , int row , int col ) const
+    {
+        return ( getCodeRow(filter,row)[col/64] >> (col%64) ) & 1 ;
+    }
+
+
+
+    bool OsiIrisCode::getMaskBit ( int row , int col ) const
+    {
+        return ( getMaskRow(row)[col/64] >> (col%64) ) & 1 ;
+    }
+
+
+
+    void OsiIrisCode::getShiftedCodeRow ( int filter , int row , int shift , uint64_t * pRow ) const
+    {
+        const uint64_t * p_code = getCodeRow(filter,row) ;
+        for ( int w = 0 ; w < mNumberOfWords ; w++ )
+        {
+            int start = ( ( 64*w + shift ) % mWidth + mWidth ) % mWidth ;
+            pRow[w] = readWrapped(p_code,start) ;
+        }
+    }
+
+
+
+    bool OsiIrisCode::isCompatible ( const OsiIrisCode & rCode ) const
+    {
+        return mWidth == rCode.mWidth && mRows == rCode.mRows && mNumberOfFilters == rCode.mNumberOfFilters ;
+    }
+
+
+
+
+
+
+    // Functions for matching
+    /////////////////////////
+
+    float OsiIrisCode::match ( const OsiIrisCode & rCode , int maxShift ) const
+    {
+        int shift ;
+        return match(rCode,maxShift,shift) ;
+    }
+
+
+
+    float OsiIrisCode::match ( const OsiIrisCode & rCode , int maxShift , int & rShift ) const
+    {
+        if ( isEmpty() || rCode.isEmpty() )
+        {
+            throw runtime_error("Cannot match because one of the packed iris codes is empty") ;
+        }
+
+        // Build the total mask = mask1 * mask2, and keep only the rows containing valid bits
+        vector<uint64_t> mask ;
+        vector<int> rows ;
+        double total = combineMasks(rCode,mask,rows) ;
+
+        // The minimum score will be returned
+        float score = 1 ;
+        rShift = 0 ;
+        if ( ! total )
+        {
+            return score ;
+        }
+
+        // Shift this code, and compare to the other one
+        vector<uint64_t> shifted(mNumberOfFilters*mNumberOfWords) ;
+        for ( int s = -maxShift ; s <= maxShift ; s++ )
+        {
+            double diff = 0 ;
+            for ( int i = 0 ; i < rows.size() ; i++ )
+            {
+                const uint64_t * p_mask = &mask[rows[i]*mNumberOfWords] ;
+                for ( int f = 0 ; f < mNumberOfFilters ; f++ )
+                {
+                    getShiftedCodeRow(f,rows[i],s,&shifted[f*mNumberOfWords]) ;
+                }
+                diff += OsiHamming::countDifferences(&shifted[0],mNumberOfWords,
+                                                     rCode.getCodeRow(0,rows[i]),(size_t)mHeight*mNumberOfWords,
+                                                     p_mask,p_mask,mNumberOfWords,mNumberOfFilters) ;
+            }
+            float mean = diff / total ;
+            if ( s == -maxShift || mean < score )
+            {
+                score = mean ;
+                rShift = s ;
+            }
+        }
+
+        return score ;
+    }
+
+
+
+    bool OsiIrisCode::verify ( const OsiIrisCode & rCode , float threshold , float & rScore , int maxShift ) const
+    {
+        if ( isEmpty() || rCode.isEmpty() )
+        {
+            throw runtime_error("Cannot match because one of the packed iris codes is empty") ;
+        }
+
+        // Build the total mask = mask1 * mask2, and keep only the rows containing valid bits
+        vector<uint64_t> mask ;
+        vector<int> rows ;
+        double total = combineMasks(rCode,mask,rows) ;
+
+        // Best complete score, and lower bound of the score for the abandoned shifts
+        float score = 1 ;
+        float bound = 1 ;
+        if ( ! total )
+        {
+            rScore = score ;
+            return score < threshold ;
+        }
+
+        // Small shifts first : for genuine pairs they quickly give a low score to beat
+        vector<uint64_t> shifted(mNumberOfFilters*mNumberOfWords) ;
+        for ( int k = 0 ; k <= 2 * maxShift ; k++ )
+        {
+            int s = ( k % 2 ) ? ( k + 1 ) / 2 : - k / 2 ;
+
+            // The partial score can only increase : stop as soon as it cannot
+            // be lower than both the best score and the threshold
+            float limit = min(score,threshold) ;
+            double diff = 0 ;
+            float mean = 0 ;
+            bool abandoned = false ;
+            for ( int i = 0 ; i < rows.size() && ! abandoned ; i++ )
+            {
+                const uint64_t * p_mask = &mask[rows[i]*mNumberOfWords] ;
+                for ( int f = 0 ; f < mNumberOfFilters ; f++ )
+                {
+                    getShiftedCodeRow(f,rows[i],s,&shifted[f*mNumberOfWords]) ;
+                }
+                diff += OsiHamming::countDifferences(&shifted[0],mNumberOfWords,
+                                                     rCode.getCodeRow(0,rows[i]),(size_t)mHeight*mNumberOfWords,
+                                                     p_mask,p_mask,mNumberOfWords,mNumberOfFilters) ;
+                mean = diff / total ;
+                abandoned = ( mean >= limit ) ;
+            }
+
+            if ( abandoned )
+            {
+                bound = min(bound,mean) ;
+            }
+            else
+            {
+                score = mean ;
+            }
+        }
+
+        // Accepted : the score is exact. Rejected : the score is a lower bound, not below the threshold
+        bool accepted = ( score < threshold ) ;
+        rScore = accepted ? score : min(score,bound) ;
+
+        return accepted ;
+    }
+
+
+
+    int OsiIrisCode::countBits ( uint64_t word )
+    {
+#if defined(__GNUC__)
+        return __builtin_popcountll(word) ;
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return (int) __popcnt64(word) ;
+#else
+        word = word - ( ( word >> 1 ) & 0x5555555555555555ULL ) ;
+        word = ( word & 0x3333333333333333ULL ) + ( ( word >> 2 ) & 0x3333333333333333ULL ) ;
+        word = ( word + ( word >> 4 ) ) & 0x0F0F0F0F0F0F0F0FULL ;
+        return (int) ( ( word * 0x0101010101010101ULL ) >> 56 ) ;
+#endif
+    }
+
+
+
+
+
+    // Functions for loading and saving
+    ///////////////////////////////////
+
+    void OsiIrisCode::load ( const string & rFilename )
+    {
+        // Open the file
+        ifstream file(rFilename.c_str(),ios::in|ios::binary) ;
+
+        // If file is not opened
+        if ( ! file )
+        {
+            throw runtime_error("Cannot load the iris template in " + rFilename) ;
+        }
+
+        // Header
+        char magic[4] ;
+        int32_t header[4] ;
+        file.read(magic,4) ;
+        file.read((char*)header,sizeof(header)) ;
+        if ( ! file || string(magic,4) != "OSIT" || header[0] != 1 || header[2] <= 0 || header[2] > 4096 )
+        {
+            throw runtime_error("Invalid iris template in " + rFilename) ;
+        }
+
+        // Kept rows
+        vector<int32_t> rows(header[2]) ;
+        file.read((char*)&rows[0],rows.size()*sizeof(int32_t)) ;
+        if ( ! file )
+        {
+            throw runtime_error("Invalid iris template in " + rFilename) ;
+        }
+        create(header[1],vector<int>(rows.begin(),rows.end()),header[3]) ;
+
+        // Words of code and mask
+        file.read((char*)&mData[0],mData.size()*sizeof(uint64_t)) ;
+        if ( ! file )
+        {
+            clear() ;
+            throw runtime_error("Error while loading iris template from " + rFilename) ;
+        }
+
+        // Close the file
+        file.close() ;
+    }
+
+
+
+    void OsiIrisCode::save ( const string & rFilename ) const
+    {
+        if ( isEmpty() )
+        {
+            throw runtime_error("Cannot save iris template " + rFilename + " because this template is not built") ;
+        }
+
+        // Open the file
+        ofstream file(rFilename.c_str(),ios::out|ios::binary) ;
+
+        // If file is not opened
+        if ( ! file )
+        {
+            throw runtime_error("Cannot save the iris template in " + rFilename) ;
+        }
+
+        // Header : version, width, number of rows, number of filters
+        int32_t header[4] = { 1 , mWidth , mHeight , mNumberOfFilters } ;
+        vector<int32_t> rows(mRows.begin(),mRows.end()) ;
+        file.write("OSIT",4) ;
+        file.write((const char*)header,sizeof(header)) ;
+        file.write((const char*)&rows[0],rows.size()*sizeof(int32_t)) ;
+
+        // Words of code and mask
+        file.write((const char*)&mData[0],mData.size()*sizeof(uint64_t)) ;
+
+        if ( ! file )
+        {
+            throw runtime_error("Error while saving iris template in " + rFilename) ;
+        }
+
+        // Close the file
+        file.close() ;
+    }
+
+
+
+
+
+    ///////////////////////////////////
+    // PRIVATE METHODS
+    ///////////////////////////////////
+
+
+    // Combine the masks of two codes, keep the rows containing valid bits, return the number of bits to compare
+    double OsiIrisCode::combineMasks ( const OsiIrisCode & rCode , vector<uint64_t> & rMask , vector<int> & rRows ) const
+    {
+        if ( ! isCompatible(rCode) )
+        {
+            throw runtime_error("Cannot match iris codes of different sizes") ;
+        }
+
+        rMask.resize(mHeight*mNumberOfWords) ;
+        rRows.clear() ;
+        double total = 0 ;
+        for ( int r = 0 ; r < mHeight ; r++ )
+        {
+            const uint64_t * p_mask1 = getMaskRow(r) ;
+            const uint64_t * p_mask2 = rCode.getMaskRow(r) ;
+            int count = 0 ;
+            for ( int w = 0 ; w < mNumberOfWords ; w++ )
+            {
+                rMask[r*mNumberOfWords+w] = p_mask1[w] & p_mask2[w] ;
+                count += countBits(rMask[r*mNumberOfWords+w]) ;
+            }
+            if ( count )
+            {
+                rRows.push_back(r) ;
+                total += count ;
+            }
+        }
+
+        // The mask is the same for all code planes
+        return total * mNumberOfFilters ;
+    }
+
+
+
+    // Read 64 bits of a row from column start, columns after the last one come from the beginning
+    uint64_t OsiIrisCode::readWrapped ( const uint64_t * pRow , int start ) const
+    {
+        int w = start / 64 ;
+        int b = start % 64 ;
+
+        uint64_t bits = pRow[w] >> b ;
+        if ( b && w+1 < mNumberOfWords )
+        {
+            bits |= pRow[w+1] << (64-b) ;
+        }
+
+        // Wrapping
+        int available = mWidth - start ;
+        if ( available < 64 )
+        {
+            bits &= ( (uint64_t)1 << available ) - 1 ;
+            bits |= pRow[0] << available ;
+        }
+
+        return bits ;
+    }
+
+} // end of namespace
+
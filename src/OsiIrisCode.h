@@ -0,0 +1,277 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_IRIS_CODE_H
+#define OSI_IRIS_CODE_H
+
+// Maximum shift (in columns of normalized iris) tested during matching
+#define OSI_MAX_SHIFT 10
+
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace osiris
+{
+
+    /** Bit-packed iris code.
+    * Store the binary iris code and its mask with one bit per pixel,
+    * in 64-bit words. Each row of the normalized iris is packed in
+    * getNumberOfWords() words, the column j being the bit (j%64) of word (j/64).\n
+    * The code is made of one plane per Gabor filter, stacked as in the iris code
+    * image built by OsiProcessings::encode(). The mask is a single plane shared by
+    * all filters : it is the normalized mask restricted to the application points.\n
+    * A code may keep only some rows of the normalized iris. Such a code is called a template :
+    * only the rows containing application points are kept, because they are the only ones
+    * taking part in the matching. Rows are kept entirely so that the shifts can be tested.
+    * @see OsiEye::packIrisCode() , OsiProcessings::match()
+    */
+    class OsiIrisCode
+    {
+
+    public :
+
+        /** Default constructor.
+        * Build an empty code.
+        */
+        OsiIrisCode ( ) ;
+
+        /** Default destructor. */
+        ~OsiIrisCode ( ) ;
+
+        /** Allocate the code and set all bits of code and mask to 0.
+        * @param width Width of normalized iris
+        * @param height Height of normalized iris
+        * @param nFilters Number of Gabor filters (number of code planes)
+        * @return void
+        */
+        void create ( int width , int height , int nFilters ) ;
+
+        /** Allocate a code keeping only some rows of the normalized iris, set all bits to 0.
+        * @param width Width of normalized iris
+        * @param rRows The rows of normalized iris to be kept, in increasing order
+        * @param nFilters Number of Gabor filters (number of code planes)
+        * @return void
+        */
+        void create ( int width , const std::vector<int> & rRows , int nFilters ) ;
+
+        /** Release memory. The code becomes empty.
+        * @return void
+        */
+        void clear ( ) ;
+
+        /** Check if the code is allocated.
+        * @return true if the code has not been created
+        */
+        bool isEmpty ( ) const ;
+
+        /** Get the width of the normalized iris.
+        * @return The number of columns
+        */
+        int getWidth ( ) const ;
+
+        /** Get the number of rows kept in one code plane.
+        * @return The height of normalized iris, or the number of kept rows for a template
+        */
+        int getHeight ( ) const ;
+
+        /** Get the row of normalized iris corresponding to a row of the code.
+        * @param row The row in the code
+        * @return The row in the normalized iris
+        */
+        int getRowIndex ( int row ) const ;
+
+        /** Get the number of code planes.
+        * @return The number of Gabor filters used for encoding
+        */
+        int getNumberOfFilters ( ) const ;
+
+        /** Get the number of 64-bit words used to store one row.
+        * @return The number of words per row
+        */
+        int getNumberOfWords ( ) const ;
+
+        /** Get the memory used by the code.
+        * @return The size in bytes of code, mask and kept rows
+        */
+        size_t getSizeInBytes ( ) const ;
+
+        /** Get one row of a code plane.
+        * @param filter The index of the code plane
+        * @param row The row in the plane
+        * @return A pointer on the first word of the row
+        */
+        uint64_t * getCodeRow ( int filter , int row ) ;
+        const uint64_t * getCodeRow ( int filter , int row ) const ;
+
+        /** Get one row of the mask.
+        * @param row The row in the mask
+        * @return A pointer on the first word of the row
+        */
+        uint64_t * getMaskRow ( int row ) ;
+        const uint64_t * getMaskRow ( int row ) const ;
+
+        /** Get all the words : the code planes (filter, row, word) followed by the mask plane (row, word).
+        * @return A pointer on the first word
+        */
+        uint64_t * getData ( ) ;
+        const uint64_t * getData ( ) const ;
+
+        /** Get the number of words of code and mask.
+        * @return The number of 64-bit words
+        */
+        size_t getDataSize ( ) const ;
+
+        /** Set one bit of the code.
+        * @param filter The index of the code plane
+        * @param row The row in the plane
+        * @param col The column
+        * @param value The bit value
+        * @return void
+        */
+        void setCodeBit ( int filter , int row , int col , bool value ) ;
+
+        /** Set one bit of the mask.
+        * @param row The row in the mask
+        * @param col The column
+        * @param value The bit value (true = pixel is used for matching)
+        * @return void
+        */
+        void setMaskBit ( int row , int col , bool value ) ;
+
+        /** Get one bit of the code.
+        * @param filter The index of the code plane
+        * @param row The row in the plane
+        * @param col The column
+        * @return The bit value
+        */
+        bool getCodeBit ( int filter , int row , int col ) const ;
+
+        /** Get one bit of the mask.
+        * @param row The row in the mask
+        * @param col The column
+        * @return The bit value
+        */
+        bool getMaskBit ( int row , int col ) const ;
+
+        /** Get one row of a code plane shifted by some columns (assuming wrapping).
+        * The column j of the shifted row is the column (j+shift) of the code.
+        * @param filter The index of the code plane
+        * @param row The row in the plane
+        * @param shift The shift in columns
+        * @param pRow The shifted row, getNumberOfWords() words. Filled by the function
+        * @return void
+        */
+        void getShiftedCodeRow ( int filter , int row , int shift , uint64_t * pRow ) const ;
+
+        /** Check if two codes can be matched (same width, kept rows and number of filters).
+        * @param rCode The other code
+        * @return true if the codes have the same size
+        */
+        bool isCompatible ( const OsiIrisCode & rCode ) const ;
+
+        /** Match two iris codes (hamming distance between codes).
+        * Same result as OsiProcessings::match() on the unpacked images : this code
+        * is shifted from -maxShift to +maxShift columns (assuming wrapping), the
+        * disagreeing bits are counted where both masks are on, and the minimum
+        * score is returned.
+        * @param rCode The other code. Must have the same size as this code.
+        * @param maxShift The maximum shift in columns
+        * @return The matching score between 0 (completely similar) and 1 (completely different)
+        */
+        float match ( const OsiIrisCode & rCode , int maxShift = OSI_MAX_SHIFT ) const ;
+
+        /** Match two iris codes and give the shift of the best score.
+        * @param rCode The other code. Must have the same size as this code.
+        * @param maxShift The maximum shift in columns
+        * @param rShift The shift in columns of this code giving the score (the smallest one in case
+        * of equality, 0 if the masks have no common bit). Filled by the function
+        * @return The matching score between 0 (completely similar) and 1 (completely different)
+        * @see match()
+        */
+        float match ( const OsiIrisCode & rCode , int maxShift , int & rShift ) const ;
+
+        /** Match two iris codes against a decision threshold.
+        * Same score as match(), but a shift is abandoned as soon as its partial
+        * hamming distance can no longer be lower than both the best score and the
+        * threshold : most impostor comparisons stop before all bits are counted.
+        * @param rCode The other code. Must have the same size as this code.
+        * @param threshold The decision threshold
+        * @param rScore The score. Exact if accepted, else a lower bound of the score (not below the threshold)
+        * @param maxShift The maximum shift in columns
+        * @return true if the score is below the threshold (accepted)
+        * @see match()
+        */
+        bool verify ( const OsiIrisCode & rCode , float threshold , float & rScore , int maxShift = OSI_MAX_SHIFT ) const ;
+
+        /** Count the number of on-bits in a word.
+        * @param word A 64-bit word
+        * @return The number of bits set to 1
+        */
+        static int countBits ( uint64_t word ) ;
+
+        /** Load the code from a binary file.
+        * @param rFilename Complete path of the file
+        * @return void
+        * @see save()
+        */
+        void load ( const std::string & rFilename ) ;
+
+        /** Save the code into a binary file.
+        * The file contains a header (sizes and kept rows) and the words of code and mask.
+        * Words are written with the byte order of the machine.
+        * @param rFilename Complete path of the file
+        * @return void
+        * @see load()
+        */
+        void save ( const std::string & rFilename ) const ;
+
+    private :
+
+        /** Width of normalized iris. */
+        int mWidth ;
+
+        /** Number of kept rows. */
+        int mHeight ;
+
+        /** The rows of normalized iris that are kept. */
+        std::vector<int> mRows ;
+
+        /** Number of code planes. */
+        int mNumberOfFilters ;
+
+        /** Number of words per row. */
+        int mNumberOfWords ;
+
+        /** The code planes followed by the mask plane. */
+        std::vector<uint64_t> mData ;
+
+        /** Combine the masks of two codes.
+        * @param rCode The other code. Must have the same size as this code.
+        * @param rMask The combined mask plane. Filled by the function
+        * @param rRows The rows containing valid bits. Filled by the function
+        * @return The number of bits to compare, for all code planes
+        */
+        double combineMasks ( const OsiIrisCode & rCode , std::vector<uint64_t> & rMask , std::vector<int> & rRows ) const ;
+
+        /** Read 64 consecutive bits of a row, wrapping around the last column.
+        * @param pRow The row
+        * @param start The first column to read
+        * @return The 64 bits, the column start being the bit 0
+        */
+        uint64_t readWrapped ( const uint64_t * pRow , int start ) const ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
@@ -6,10 +6,15 @@
 * License : BSD
 ********************************************************/
 
+#include <algorithm>
 #include <fstream>
 #include <iterator>
+#include <sstream>
 #include <stdexcept>
+#include "OsiHamming.h"
 #include "OsiManager.h"
+#include "OsiModelBundle.h"
+#include "OsiScoreWriter.h"
 #include "OsiStringUtils.h"
 
 using namespace std ;
@@ -30,21 +35,47 @@ namespace osiris
         mMapBool["Process normalization"] = &mProcessNormalization ;
         mMapBool["Process encoding"] = &mProcessEncoding ;
         mMapBool["Process matching"] = &mProcessMatching ;
+        mMapBool["Process identification"] = &mProcessIdentification ;
+        mMapBool["Process all-vs-all matching"] = &mProcessAllVsAll ;
+        mMapBool["Process server"] = &mProcessServer ;
+        mMapBool["Process conversion of matching scores"] = &mProcessConversionOfScores ;
         mMapBool["Use the mask provided by osiris"] = &mUseMask ;
+        mMapBool["Use gallery index"] = &mUseGalleryIndex ;
+        mMapBool["Use cascade search"] = &mUseCascadeSearch ;
+        mMapBool["Compress masks of iris code archive"] = &mCompressMasksOfCodeArchive ;
+        mMapBool["Use FFT for encoding"] = &mUseFourierEncoding ;
+        mMapBool["Encode only at application points"] = &mEncodeOnlyApplicationPoints ;
+        mMapBool["Use fixed-point encoding"] = &mUseFixedPointEncoding ;
+        mMapBool["Use default model"] = &mUseDefaultModel ;
+        mMapBool["Use bilinear normalization"] = &mUseBilinearNormalization ;
         mMapString["Load List of images"] = &mFilenameListOfImages ;
+        mMapString["Load List of gallery images"] = &mFilenameListOfGalleryImages ;
         mMapString["Load original images"] = &mInputDirOriginalImages ;
         mMapString["Load parameters"] = &mInputDirParameters ;
         mMapString["Load masks"] = &mInputDirMasks ;
         mMapString["Load normalized images"] = &mInputDirNormalizedImages ;
         mMapString["Load normalized masks"] = &mInputDirNormalizedMasks ;
         mMapString["Load iris codes"] = &mInputDirIrisCodes ;
+        mMapString["Load iris templates"] = &mInputDirTemplates ;
+        mMapString["Load gallery file"] = &mInputFileGallery ;
+        mMapString["Load binary matching scores"] = &mInputFileBinaryScores ;
+        mMapString["Load iris code archive"] = &mInputFileCodeArchive ;
+        mMapString["Load model bundle"] = &mInputFileModelBundle ;
         mMapString["Save segmented images"] = &mOutputDirSegmentedImages ;
         mMapString["Save contours parameters"] = &mOutputDirParameters ;
         mMapString["Save masks of iris"] = &mOutputDirMasks ;
         mMapString["Save normalized images"] = &mOutputDirNormalizedImages ;
         mMapString["Save normalized masks"] = &mOutputDirNormalizedMasks ;
         mMapString["Save iris codes"] = &mOutputDirIrisCodes ;
+        mMapString["Save iris templates"] = &mOutputDirTemplates ;
         mMapString["Save matching scores"] = &mOutputFileMatchingScores ;
+        mMapString["Save binary matching scores"] = &mOutputFileBinaryScores ;
+        mMapString["Save identification results"] = &mOutputFileIdentification ;
+        mMapString["Save matrix of scores"] = &mOutputFileMatrixOfScores ;
+        mMapString["Save gallery file"] = &mOutputFileGallery ;
+        mMapString["Save iris code archive"] = &mOutputFileCodeArchive ;
+        mMapString["Save model bundle"] = &mOutputFileModelBundle ;
+        mMapString["Server socket"] = &mServerSocket ;
         mMapInt["Minimum diameter for pupil"] = &mMinPupilDiameter ;
         mMapInt["Maximum diameter for pupil"] = &mMaxPupilDiameter ;
         mMapInt["Minimum diameter for iris"] = &mMinIrisDiameter ;
@@ -53,12 +84,29 @@ namespace osiris
         mMapInt["Height of normalized image"] = &mHeightOfNormalizedIris ;
         mMapString["Load Gabor filters"] = &mFilenameGaborFilters ;
         mMapString["Load Application points"] = &mFilenameApplicationPoints ;
+        mMapInt["Number of candidates"] = &mNumberOfCandidates ;
+        mMapInt["Size of template cache (MB)"] = &mSizeOfTemplateCache ;
+        mMapInt["Number of threads"] = &mNumberOfThreads ;
+        mMapInt["Size of matrix tiles"] = &mSizeOfMatrixTiles ;
+        mMapInt["Size of probe batches"] = &mSizeOfProbeBatches ;
+        mMapInt["Size of encoding batches"] = &mSizeOfEncodingBatches ;
+        mMapFloat["Decision threshold"] = &mDecisionThreshold ;
+        mMapInt["Radius of index search"] = &mRadiusOfIndexSearch ;
+        mMapInt["Minimum votes of index search"] = &mMinimumVotesOfIndexSearch ;
+        mMapInt["First filter of cascade"] = &mFirstFilterOfCascade ;
+        mMapInt["Number of filters of cascade"] = &mNumberOfFiltersOfCascade ;
+        mMapFloat["Rejection threshold of cascade"] = &mRejectionThresholdOfCascade ;
+        mMapInt["Number of survivors of cascade"] = &mNumberOfSurvivorsOfCascade ;
+        mMapInt["Rank of separable filters"] = &mRankOfSeparableFilters ;
+        mMapFloat["Minimum agreement with dense filters"] = &mMinimumAgreementWithDenseFilters ;
+        mMapString["Hamming kernel"] = &mHammingKernel ;
         mMapString["Suffix for segmented images"] = &mSuffixSegmentedImages ;
         mMapString["Suffix for parameters"] = &mSuffixParameters ;
         mMapString["Suffix for masks of iris"] = &mSuffixMasks ;
         mMapString["Suffix for normalized images"] = &mSuffixNormalizedImages ;
         mMapString["Suffix for normalized masks"] = &mSuffixNormalizedMasks ;
         mMapString["Suffix for iris codes"] = &mSuffixIrisCodes ;
+        mMapString["Suffix for iris templates"] = &mSuffixTemplates ;
 
         // Initialize all parameters
         initConfiguration() ;        
@@ -104,17 +152,36 @@ namespace osiris
         mProcessNormalization = false ;
         mProcessEncoding = false ;
         mProcessMatching = false ;
+        mProcessIdentification = false ;
+        mProcessAllVsAll = false ;
+        mProcessServer = false ;
+        mProcessConversionOfScores = false ;
         mUseMask = true ;
+        mUseGalleryIndex = false ;
+        mUseCascadeSearch = false ;
+        mCompressMasksOfCodeArchive = true ;
+        mUseFourierEncoding = false ;
+        mEncodeOnlyApplicationPoints = false ;
+        mUseFixedPointEncoding = false ;
+        mUseDefaultModel = false ;
+        mUseBilinearNormalization = false ;
 
         // Inputs
         mListOfImages.clear() ;
         mFilenameListOfImages = "" ;
+        mListOfGalleryImages.clear() ;
+        mFilenameListOfGalleryImages = "" ;
         mInputDirOriginalImages = "" ;
         mInputDirMasks = "" ;
         mInputDirParameters = "" ;
         mInputDirNormalizedImages = "" ;
         mInputDirNormalizedMasks = "" ;
         mInputDirIrisCodes = "" ;
+        mInputDirTemplates = "" ;
+        mInputFileGallery = "" ;
+        mInputFileBinaryScores = "" ;
+        mInputFileCodeArchive = "" ;
+        mInputFileModelBundle = "" ;
 
         // Outputs
         mOutputDirSegmentedImages = "" ;
@@ -123,7 +190,15 @@ namespace osiris
         mOutputDirNormalizedImages = "" ;
         mOutputDirNormalizedMasks = "" ;
         mOutputDirIrisCodes = "" ;
+        mOutputDirTemplates = "" ;
         mOutputFileMatchingScores = "" ;
+        mOutputFileBinaryScores = "" ;
+        mOutputFileIdentification = "" ;
+        mOutputFileMatrixOfScores = "" ;
+        mOutputFileGallery = "" ;
+        mOutputFileCodeArchive = "" ;
+        mOutputFileModelBundle = "" ;
+        mServerSocket = "/tmp/osiris.sock" ;
 
         // Parameters
         mMinPupilDiameter = 21 ;
@@ -135,7 +210,26 @@ namespace osiris
         mFilenameGaborFilters = "./filters.txt" ;
         mFilenameApplicationPoints = "./points.txt" ;
         mGaborFilters.clear() ;
+        mGaborSpectra.clear() ;
+        mSeparableGaborFilters.clear() ;
+        mFixedPointGaborFilters.clear() ;
         mpApplicationPoints = 0 ;
+        mNumberOfCandidates = 5 ;
+        mSizeOfTemplateCache = 256 ;
+        mNumberOfThreads = 0 ;
+        mSizeOfMatrixTiles = 64 ;
+        mSizeOfProbeBatches = 16 ;
+        mSizeOfEncodingBatches = 1 ;
+        mDecisionThreshold = 0.32 ;
+        mRadiusOfIndexSearch = 2 ;
+        mMinimumVotesOfIndexSearch = 4 ;
+        mFirstFilterOfCascade = 0 ;
+        mNumberOfFiltersOfCascade = 2 ;
+        mRejectionThresholdOfCascade = 0.42 ;
+        mNumberOfSurvivorsOfCascade = 200 ;
+        mRankOfSeparableFilters = 0 ;
+        mMinimumAgreementWithDenseFilters = 0 ;
+        mHammingKernel = "auto" ;
 
         // Suffix for filenames
         mSuffixSegmentedImages = "_segm.bmp" ;
@@ -144,6 +238,7 @@ namespace osiris
         mSuffixNormalizedImages = "_imno.bmp" ;
         mSuffixNormalizedMasks = "_mano.bmp" ;
         mSuffixIrisCodes = "_code.bmp" ;
+        mSuffixTemplates = "_tmpl.bin" ;
     }
 
 
@@ -212,6 +307,10 @@ namespace osiris
                         else if ( mMapInt.find(key) != mMapInt.end() )
                             *mMapInt[key] = osu.fromString<int>(value) ;
 
+                        // Option is type float
+                        else if ( mMapFloat.find(key) != mMapFloat.end() )
+                            *mMapFloat[key] = osu.fromString<float>(value) ;
+
                         // Option is type string
 						else if (mMapString.find(key) != mMapString.end()) {
 							if (key.substr(0, 4).compare("Load") == 0 |
@@ -232,19 +331,78 @@ namespace osiris
         }
 
         
-        // Load the list containing all images
-        loadListOfImages() ;
+        // Load the list containing all images (optional for the server)
+        if ( ! mProcessServer || mFilenameListOfImages != "" )
+        {
+            loadListOfImages(mFilenameListOfImages,mListOfImages) ;
+        }
+
+        // Load the list of images to be enrolled in the gallery (optional for all-vs-all matching,
+        // server, and identification with a gallery file)
+        if ( ( mProcessIdentification && mInputFileGallery == "" ) ||
+             ( ( mProcessIdentification || mProcessAllVsAll || mProcessServer ) && mFilenameListOfGalleryImages != "" ) )
+        {
+            loadListOfImages(mFilenameListOfGalleryImages,mListOfGalleryImages) ;
+        }
+
+        // Load the datas for Gabor filters, and the application points (also needed to extract or encode the
+        // templates), from a model bundle or from the textfiles. Both are needed to save a model bundle
+        bool load_filters = mProcessEncoding || mOutputFileModelBundle != "" ;
+        bool load_points = mProcessMatching || mProcessIdentification || mProcessAllVsAll || mProcessServer || mOutputDirTemplates != "" ||
+                           ( mProcessEncoding && mEncodeOnlyApplicationPoints ) || mOutputFileModelBundle != "" ;
+        if ( mInputFileModelBundle != "" || mUseDefaultModel )
+        {
+            loadModelBundle(load_filters,load_points) ;
+        }
+        else
+        {
+            if ( load_filters && mFilenameGaborFilters != "" )
+            {
+                loadGaborFilters() ;
+            }
+            if ( load_points && mFilenameApplicationPoints != "" )
+            {
+                loadApplicationPoints() ;
+            }
+        }
+
+        // Save the model bundle, to be loaded by the next runs
+        if ( mOutputFileModelBundle != "" )
+        {
+            if ( mGaborFilters.empty() || ! mpApplicationPoints )
+            {
+                throw runtime_error("Cannot save the model bundle without Gabor filters and application points") ;
+            }
+            OsiModelBundle::save(mOutputFileModelBundle,mGaborFilters,mpApplicationPoints) ;
+        }
+
+        // Spectra of the Gabor filters, computed once for all eyes
+        if ( mProcessEncoding && mUseFourierEncoding && mGaborFilters.size() )
+        {
+            mGaborSpectra.create(mGaborFilters,mWidthOfNormalizedIris,mHeightOfNormalizedIris) ;
+        }
+
+        // Separable approximations of the Gabor filters (a rank of 0 keeps the dense filters)
+        if ( mProcessEncoding && ! mUseFourierEncoding && mRankOfSeparableFilters > 0 && mGaborFilters.size() )
+        {
+            mSeparableGaborFilters.create(mGaborFilters,mRankOfSeparableFilters) ;
+        }
 
-        // Load the datas for Gabor filters
-        if ( mProcessEncoding && mFilenameGaborFilters != "" )
+        // Gabor filters quantized to integers, and check of their vector kernel
+        if ( mProcessEncoding && mUseFixedPointEncoding && mGaborFilters.size() )
         {
-            loadGaborFilters() ;
+            mFixedPointGaborFilters.create(mGaborFilters) ;
+            if ( ! OsiFixedPointFilters::checkKernels() )
+            {
+                throw runtime_error("The kernels of fixed-point encoding do not give the same results") ;
+            }
         }
 
-        // Load the application points
-        if ( mProcessMatching && mFilenameApplicationPoints != "" )
+        // Choose the kernel counting the different bits of the codes, and check it
+        OsiHamming::setKernel(mHammingKernel) ;
+        if ( ! OsiHamming::checkKernels() )
         {
-            loadApplicationPoints() ;
+            throw runtime_error("The kernels counting the different bits of the codes do not give the same results") ;
         }
     }
 
@@ -276,6 +434,22 @@ namespace osiris
         {
             cout << "| matching |" ;
         }
+        if ( mProcessIdentification )
+        {
+            cout << "| identification |" ;
+        }
+        if ( mProcessAllVsAll )
+        {
+            cout << "| all-vs-all matching |" ;
+        }
+        if ( mProcessServer )
+        {
+            cout << "| server |" ;
+        }
+        if ( mProcessConversionOfScores )
+        {
+            cout << "| conversion of matching scores |" ;
+        }
         if ( ! mUseMask )
         {
             cout << " do not use osiris masks" ;
@@ -283,6 +457,14 @@ namespace osiris
         cout << endl ;
 
         cout << "- List of images " << mFilenameListOfImages << " contains " << mListOfImages.size() << " images" << endl ;
+        if ( ! mListOfGalleryImages.empty() )
+        {
+            cout << "- List of gallery images " << mFilenameListOfGalleryImages << " contains " << mListOfGalleryImages.size() << " images" << endl ;
+        }
+        if ( ( mProcessIdentification || mProcessServer ) && mInputFileGallery != "" )
+        {
+            cout << "- Gallery will be mapped from : " << mInputFileGallery << endl ;
+        }
         
         cout << endl ;
 
@@ -310,6 +492,22 @@ namespace osiris
         {
             cout << "- Iris codes will be loaded from : " << mInputDirIrisCodes << endl ;
         }
+        if ( mInputDirTemplates != "" )
+        {
+            cout << "- Iris templates will be loaded from : " << mInputDirTemplates << endl ;
+        }
+        if ( mInputFileCodeArchive != "" )
+        {
+            cout << "- Iris codes and normalized masks will be loaded from the archive : " << mInputFileCodeArchive << endl ;
+        }
+        if ( mInputFileModelBundle != "" )
+        {
+            cout << "- Gabor filters and application points are loaded from the model bundle : " << mInputFileModelBundle << endl ;
+        }
+        else if ( mUseDefaultModel )
+        {
+            cout << "- Gabor filters and application points are loaded from the default model bundle" << endl ;
+        }
 
         cout << endl ;
 
@@ -337,10 +535,73 @@ namespace osiris
         {
             cout << "- Iris codes will be saved as : " << mOutputDirIrisCodes << "XXX" << mSuffixIrisCodes << endl ;
         }
-        if ( mProcessMatching && mOutputFileMatchingScores != "" )
+        if ( mOutputDirTemplates != "" )
+        {
+            cout << "- Iris templates will be saved as : " << mOutputDirTemplates << "XXX" << mSuffixTemplates << endl ;
+        }
+        if ( mOutputFileCodeArchive != "" )
+        {
+            cout << "- Iris codes and normalized masks will be saved in the archive : " << mOutputFileCodeArchive
+                 << ( mCompressMasksOfCodeArchive ? " (run-length coded masks)" : "" ) << endl ;
+        }
+        if ( mOutputFileModelBundle != "" )
+        {
+            cout << "- Gabor filters and application points are saved in the model bundle : " << mOutputFileModelBundle << endl ;
+        }
+        if ( ( mProcessMatching || mProcessConversionOfScores ) && mOutputFileMatchingScores != "" )
         {
             cout << "- Matching scores will be saved in : " << mOutputFileMatchingScores << endl ;
         }
+        if ( mProcessMatching && mOutputFileBinaryScores != "" )
+        {
+            cout << "- Binary matching scores will be saved in : " << mOutputFileBinaryScores << endl ;
+        }
+        if ( mProcessConversionOfScores )
+        {
+            cout << "- Binary matching scores will be loaded from : " << mInputFileBinaryScores << endl ;
+        }
+        if ( mProcessIdentification && mOutputFileIdentification != "" )
+        {
+            cout << "- " << mNumberOfCandidates << " best candidates will be saved in : " << mOutputFileIdentification << endl ;
+        }
+        if ( mProcessMatching )
+        {
+            cout << "- Up to " << mSizeOfTemplateCache << " MB of templates will be kept in cache" << endl ;
+        }
+        if ( mProcessAllVsAll && mOutputFileMatrixOfScores != "" )
+        {
+            cout << "- Matrix of scores will be saved in : " << mOutputFileMatrixOfScores << endl ;
+        }
+        if ( ( mProcessIdentification || mProcessServer ) && mOutputFileGallery != "" )
+        {
+            cout << "- Gallery will be saved in : " << mOutputFileGallery << endl ;
+        }
+        if ( mProcessIdentification && ! mUseGalleryIndex )
+        {
+            cout << "- Probes will be searched in the gallery by batches of " << mSizeOfProbeBatches << endl ;
+        }
+        if ( mProcessEncoding && mSizeOfEncodingBatches > 1 )
+        {
+            cout << "- Gallery images, and images without matching, will be encoded by batches of " << mSizeOfEncodingBatches << endl ;
+        }
+        if ( ( mProcessIdentification || mProcessServer ) && mUseGalleryIndex )
+        {
+            cout << "- Gallery will be indexed (radius " << mRadiusOfIndexSearch << ", " << mMinimumVotesOfIndexSearch << " votes)" << endl ;
+        }
+        if ( ( mProcessIdentification || mProcessServer ) && ! mUseGalleryIndex && mUseCascadeSearch )
+        {
+            cout << "- Gallery will be searched on " << mNumberOfFiltersOfCascade << " filters from filter " << mFirstFilterOfCascade
+                 << " first, then the best " << mNumberOfSurvivorsOfCascade << " entries below " << mRejectionThresholdOfCascade
+                 << " on all filters" << endl ;
+        }
+        if ( mProcessMatching || mProcessIdentification || mProcessAllVsAll || mProcessServer )
+        {
+            cout << "- Different bits of the codes will be counted with the " << OsiHamming::getName(OsiHamming::getKernel()) << " kernel" << endl ;
+        }
+        if ( mProcessServer )
+        {
+            cout << "- Requests will be answered on : " << mServerSocket << " (decision threshold " << mDecisionThreshold << ")" << endl ;
+        }
 
         cout << endl ;
 
@@ -350,10 +611,15 @@ namespace osiris
             cout << "- Iris diameter ranges from " << mMinIrisDiameter << " to " << mMaxIrisDiameter << endl ;
         }
 
-        if ( mProcessNormalization || mProcessMatching || mProcessEncoding )
+        if ( mProcessNormalization || mProcessMatching || mProcessIdentification || mProcessAllVsAll || mProcessServer || mProcessEncoding )
         {
             cout << "- Size of normalized iris is " << mWidthOfNormalizedIris << " x " << mHeightOfNormalizedIris << endl ;
         }
+
+        if ( mProcessNormalization && mUseBilinearNormalization )
+        {
+            cout << "- Normalized images are interpolated between pixels (bilinear)" << endl ;
+        }
         
         cout << endl ;
 
@@ -365,7 +631,42 @@ namespace osiris
             cout << endl ;
         }
 
-        if ( mProcessMatching && mpApplicationPoints )
+        if ( mProcessEncoding && ! mGaborSpectra.isEmpty() )
+        {
+            cout << "- Encoding in the frequency domain : DFT of " << mGaborSpectra.getWidth() << " x " << mGaborSpectra.getPaddedHeight() << endl ;
+        }
+
+        if ( mProcessEncoding && ! mSeparableGaborFilters.isEmpty() )
+        {
+            cout << "- Separable Gabor filters of rank " << mRankOfSeparableFilters << " (terms, error, multiplications per pixel) : " ;
+            for ( int f = 0 ; f < mSeparableGaborFilters.getNumberOfFilters() ; f++ )
+            {
+                int terms = mSeparableGaborFilters.getNumberOfTerms(f) ;
+                cout << terms << " " << mSeparableGaborFilters.getError(f) << " "
+                     << terms*(mGaborFilters[f]->rows+mGaborFilters[f]->cols) << "/" << mGaborFilters[f]->rows*mGaborFilters[f]->cols << " ; " ;
+            }
+            cout << endl ;
+        }
+
+        if ( mProcessEncoding && ! mFixedPointGaborFilters.isEmpty() )
+        {
+            cout << "- Fixed-point encoding with " << OsiFixedPointFilters::getKernel() << " kernel (scale, rounding error) : " ;
+            for ( int f = 0 ; f < mFixedPointGaborFilters.getNumberOfFilters() ; f++ )
+                cout << "2^" << mFixedPointGaborFilters.getScale(f) << " " << mFixedPointGaborFilters.getError(f) << " ; " ;
+            cout << endl ;
+        }
+
+        if ( mProcessEncoding && mEncodeOnlyApplicationPoints )
+        {
+            cout << "- Encoding only at application points, for shifts up to " << OSI_MAX_SHIFT << " columns" << endl ;
+        }
+
+        if ( mProcessEncoding && mMinimumAgreementWithDenseFilters > 0 )
+        {
+            cout << "- Minimum agreement of iris codes with dense filters is " << mMinimumAgreementWithDenseFilters << endl ;
+        }
+
+        if ( mpApplicationPoints )
         {
             double max_val ;
             cvMinMaxLoc(mpApplicationPoints,0,&max_val) ;
@@ -478,20 +779,57 @@ namespace osiris
 
 
 
-    // Load the application points from a textfile
-    void OsiManager::loadListOfImages ( )
+    // Load the Gabor filters and the application points from a binary model bundle
+    void OsiManager::loadModelBundle ( bool filters , bool points )
+    {
+        // The file of the configuration, or the bundle compiled into Osiris
+        OsiModelBundle bundle ;
+        if ( mInputFileModelBundle != "" )
+        {
+            bundle.open(mInputFileModelBundle) ;
+        }
+        else
+        {
+            bundle.openDefault() ;
+        }
+
+        if ( filters )
+        {
+            bundle.getFilters(mGaborFilters) ;
+        }
+
+        // The points are not rescaled : the bundle must be built for the same normalized iris
+        if ( points )
+        {
+            if ( bundle.getWidth() != mWidthOfNormalizedIris || bundle.getHeight() != mHeightOfNormalizedIris )
+            {
+                throw runtime_error("The application points of the model bundle do not fit the size of normalized iris") ;
+            }
+            mpApplicationPoints = bundle.getApplicationPoints() ;
+        }
+
+    } // end of function
+
+
+
+
+
+
+
+    // Load the list of images from a textfile
+    void OsiManager::loadListOfImages ( const string & rFilename , vector<string> & rList )
     {
         // Open the file
-        ifstream file(mFilenameListOfImages.c_str(),ios::in) ;
+        ifstream file(rFilename.c_str(),ios::in) ;
 
         // If file is not opened
         if ( ! file )
         {
-            throw runtime_error("Cannot load the list of images in " + mFilenameListOfImages) ;
+            throw runtime_error("Cannot load the list of images in " + rFilename) ;
         }
 
         // Fill in the list
-        copy(istream_iterator<string>(file),istream_iterator<string>(),back_inserter(mListOfImages)) ;
+        copy(istream_iterator<string>(file),istream_iterator<string>(),back_inserter(rList)) ;
 
         // Close the file
         file.close() ;
@@ -505,6 +843,103 @@ namespace osiris
 
     // Load, segment, normalize, encode, and save according to user configuration
     void OsiManager::processOneEye ( const string & rFileName , OsiEye & rEye )
+    {
+        prepareEye(rFileName,rEye) ;
+        encodeEye(rFileName,rEye) ;
+        finishEye(rFileName,rEye) ;
+
+    } // end of function
+
+
+
+
+
+
+    // Process several eyes : each eye is loaded, segmented and normalized, then all eyes are encoded
+    // together when the dense filters are used (one by one otherwise), then each eye is saved
+    void OsiManager::processEyes ( const vector<string> & rFileNames , vector<OsiEye> & rEyes , vector<bool> & rProcessed )
+    {
+        rProcessed.assign(rFileNames.size(),false) ;
+
+        // Load, segment and normalize
+        for ( int i = 0 ; i < rFileNames.size() ; i++ )
+        {
+            try
+            {
+                prepareEye(rFileNames[i],rEyes[i]) ;
+                rProcessed[i] = true ;
+            }
+            catch ( exception & e )
+            {
+                cout << e.what() << endl ;
+            }
+        }
+
+        // Encode
+        bool dense = mProcessEncoding && ! mEncodeOnlyApplicationPoints && ! mUseFixedPointEncoding &&
+                     ! mUseFourierEncoding && mSeparableGaborFilters.isEmpty() ;
+        if ( dense )
+        {
+            vector<OsiEye*> eyes ;
+            for ( int i = 0 ; i < rFileNames.size() ; i++ )
+            {
+                if ( rProcessed[i] )
+                {
+                    eyes.push_back(&rEyes[i]) ;
+                }
+            }
+            try
+            {
+                OsiEye::encode(eyes,mGaborFilters,mNumberOfThreads) ;
+            }
+            catch ( exception & e )
+            {
+                cout << e.what() << endl ;
+                rProcessed.assign(rFileNames.size(),false) ;
+            }
+        }
+        for ( int i = 0 ; i < rFileNames.size() && ! dense ; i++ )
+        {
+            try
+            {
+                if ( rProcessed[i] )
+                {
+                    encodeEye(rFileNames[i],rEyes[i]) ;
+                }
+            }
+            catch ( exception & e )
+            {
+                cout << e.what() << endl ;
+                rProcessed[i] = false ;
+            }
+        }
+
+        // Load the iris codes, extract the templates and save
+        for ( int i = 0 ; i < rFileNames.size() ; i++ )
+        {
+            try
+            {
+                if ( rProcessed[i] )
+                {
+                    finishEye(rFileNames[i],rEyes[i]) ;
+                }
+            }
+            catch ( exception & e )
+            {
+                cout << e.what() << endl ;
+                rProcessed[i] = false ;
+            }
+        }
+
+    } // end of function
+
+
+
+
+
+
+    // Load, segment and normalize according to user configuration
+    void OsiManager::prepareEye ( const string & rFileName , OsiEye & rEye )
     {
         //cout << "Process " << rFileName << endl ;
 
@@ -575,7 +1010,7 @@ namespace osiris
         // Normalization step
         if ( mProcessNormalization )
         {
-            rEye.normalize(mWidthOfNormalizedIris,mHeightOfNormalizedIris) ;
+            rEye.normalize(mWidthOfNormalizedIris,mHeightOfNormalizedIris,mUseBilinearNormalization) ;
         }
 
         // Load normalized image
@@ -588,26 +1023,118 @@ namespace osiris
         if ( mInputDirNormalizedMasks != "" )
         {
             rEye.loadNormalizedMask(mInputDirNormalizedMasks+short_name+mSuffixNormalizedMasks) ;
-        }        
+        }
+
+    } // end of function
+
+
+
 
 
 
+    // Encode according to user configuration
+    void OsiManager::encodeEye ( const string & rFileName , OsiEye & rEye )
+    {
+        // Strings handle
+        OsiStringUtils osu ;
+
+        // Get eye name
+        string short_name = osu.extractFileName(rFileName) ;
+
         /////////////////////////////////////////////////////////////////
-        // ENCODING : process, load
+        // ENCODING : process
         /////////////////////////////////////////////////////////////////
 
         // Encoding step
         if ( mProcessEncoding )
         {
-            rEye.encode(mGaborFilters) ;
+            if ( mEncodeOnlyApplicationPoints && mUseFixedPointEncoding )
+            {
+                rEye.encodeTemplate(mFixedPointGaborFilters,mpApplicationPoints) ;
+            }
+            else if ( mEncodeOnlyApplicationPoints )
+            {
+                rEye.encodeTemplate(mGaborFilters,mpApplicationPoints) ;
+            }
+            else if ( mUseFixedPointEncoding )
+            {
+                rEye.encode(mFixedPointGaborFilters) ;
+            }
+            else if ( mUseFourierEncoding )
+            {
+                rEye.encode(mGaborSpectra) ;
+            }
+            else if ( ! mSeparableGaborFilters.isEmpty() )
+            {
+                rEye.encode(mSeparableGaborFilters) ;
+            }
+            else
+            {
+                rEye.encode(mGaborFilters) ;
+            }
+
+            // Check the approximated iris code against the dense one
+            if ( ! mEncodeOnlyApplicationPoints && ( mUseFixedPointEncoding || mUseFourierEncoding || ! mSeparableGaborFilters.isEmpty() ) && mMinimumAgreementWithDenseFilters > 0 )
+            {
+                float agreement = rEye.getAgreement(mGaborFilters) ;
+                if ( agreement < mMinimumAgreementWithDenseFilters )
+                {
+                    throw runtime_error("Iris code of " + short_name + " agrees with dense filters on " +
+                                        osu.toString(agreement) + " of pixels only") ;
+                }
+            }
         }
 
+    } // end of function
+
+
+
+
+
+
+    // Load the iris code, extract the template and save according to user configuration
+    void OsiManager::finishEye ( const string & rFileName , OsiEye & rEye )
+    {
+        // Strings handle
+        OsiStringUtils osu ;
+
+        // Get eye name
+        string short_name = osu.extractFileName(rFileName) ;
+
+        /////////////////////////////////////////////////////////////////
+        // ENCODING : load
+        /////////////////////////////////////////////////////////////////
+
         // Load iris code
         if ( mInputDirIrisCodes != "" )
         {
             rEye.loadIrisCode(mInputDirIrisCodes+short_name+mSuffixIrisCodes) ;
         }
 
+        // Load iris code and normalized mask from the archive
+        if ( mInputFileCodeArchive != "" )
+        {
+            rEye.loadIrisCode(mInputCodeArchive,short_name) ;
+        }
+
+
+
+        /////////////////////////////////////////////////////////////////
+        // TEMPLATE : extract, load
+        /////////////////////////////////////////////////////////////////
+
+        // Extract the template from the iris code, only the rows of application points are kept
+        if ( mpApplicationPoints && ( ( mProcessEncoding && ! mEncodeOnlyApplicationPoints ) || mInputDirIrisCodes != "" || mInputFileCodeArchive != "" ) )
+        {
+            rEye.extractTemplate(mpApplicationPoints) ;
+        }
+
+        // Load template
+        if ( mInputDirTemplates != "" )
+        {
+            rEye.loadTemplate(mInputDirTemplates+short_name+mSuffixTemplates) ;
+        }
+
 
 
         /////////////////////////////////////////////////////////////////
@@ -657,7 +1184,7 @@ namespace osiris
         // Save normalized mask
         if ( mOutputDirNormalizedMasks != "" )
         {
-            if ( ! mProcessNormalization && ( mInputDirNormalizedMasks == "" ) )
+            if ( ! mProcessNormalization && ( mInputDirNormalizedMasks == "" ) && ( mInputFileCodeArchive == "" ) )
             {
                 cout << "Cannot save normalized masks because they are neither computed nor loaded" << endl ;
             }
@@ -670,7 +1197,7 @@ namespace osiris
         // Save iris code
         if ( mOutputDirIrisCodes != "" )
         {
-            if ( ! mProcessEncoding && ( mInputDirIrisCodes == "" ) )
+            if ( ( ! mProcessEncoding || mEncodeOnlyApplicationPoints ) && ( mInputDirIrisCodes == "" ) && ( mInputFileCodeArchive == "" ) )
             {
                 cout << "Cannot save iris codes because they are neither computed nor loaded" << endl ;
             }
@@ -680,10 +1207,36 @@ namespace osiris
             }    
         }
 
-    } // end of function
-
-
-
+        // Save iris code and normalized mask in the archive
+        if ( mOutputFileCodeArchive != "" )
+        {
+            if ( ( ! mProcessEncoding || mEncodeOnlyApplicationPoints ) && ( mInputDirIrisCodes == "" ) && ( mInputFileCodeArchive == "" ) )
+            {
+                cout << "Cannot archive iris codes because they are neither computed nor loaded" << endl ;
+            }
+            else
+            {
+                rEye.saveIrisCode(mOutputCodeArchive,short_name) ;
+            }
+        }
+
+        // Save template
+        if ( mOutputDirTemplates != "" )
+        {
+            if ( rEye.getTemplate().isEmpty() )
+            {
+                cout << "Cannot save iris templates because they are neither computed nor loaded" << endl ;
+            }
+            else
+            {
+                rEye.saveTemplate(mOutputDirTemplates+short_name+mSuffixTemplates) ;
+            }
+        }
+
+    } // end of function
+
+
+
 
 
 
@@ -700,6 +1253,58 @@ namespace osiris
         cout << "================" << endl ;
         cout << endl ;
 
+        // Archives of iris codes are shared by all eyes
+        if ( mInputFileCodeArchive != "" )
+        {
+            mInputCodeArchive.open(mInputFileCodeArchive) ;
+        }
+        if ( mOutputFileCodeArchive != "" )
+        {
+            mOutputCodeArchive.create(mOutputFileCodeArchive,mCompressMasksOfCodeArchive) ;
+        }
+
+        if ( mProcessServer )
+        {
+            runServer() ;
+        }
+        else if ( mProcessIdentification )
+        {
+            runIdentification() ;
+        }
+        else if ( mProcessAllVsAll )
+        {
+            runAllVsAll() ;
+        }
+        else if ( mProcessConversionOfScores )
+        {
+            cout << "Convert the matching scores of " << mInputFileBinaryScores << endl ;
+            OsiScoreWriter::convert(mInputFileBinaryScores,mListOfImages,mOutputFileMatchingScores) ;
+        }
+        else
+        {
+            processListOfImages() ;
+        }
+
+        // Write the index of the archive
+        mInputCodeArchive.close() ;
+        mOutputCodeArchive.close() ;
+
+        cout << endl ;
+        cout << "==============" << endl ;
+        cout << "End processing" << endl ;
+        cout << "==============" << endl ;
+        cout << endl ;
+
+    } // end of function
+
+
+
+
+
+
+    // Process all images of the list, two by two if matching is requested
+    void OsiManager::processListOfImages ( )
+    {
         // If matching is requested, create a file
         ofstream result_matching ;
         if ( mProcessMatching && mOutputFileMatchingScores != "" )
@@ -715,6 +1320,16 @@ namespace osiris
             }
         }
 
+        // Binary scores are written by a background thread
+        OsiScoreWriter binary_matching ;
+        if ( mProcessMatching && mOutputFileBinaryScores != "" )
+        {
+            binary_matching.open(mOutputFileBinaryScores) ;
+        }
+
+        // Templates of the last matched eyes
+        OsiTemplateCache cache((size_t)max(mSizeOfTemplateCache,0)*1024*1024) ;
+
         for ( int i = 0 ; i < mListOfImages.size() ; i++ )
         {
             // Message on prompt command to know the progress
@@ -722,29 +1337,45 @@ namespace osiris
 
             try
             {
-                // Process the eye
-                OsiEye eye ;
-                processOneEye(mListOfImages[i],eye) ;            
+                // Process the eyes alone by batches if matching is not requested
+                if ( ! mProcessMatching )
+                {
+                    int last = min(i+max(mSizeOfEncodingBatches,1),(int)mListOfImages.size()) ;
+                    vector<string> names(mListOfImages.begin()+i,mListOfImages.begin()+last) ;
+                    vector<OsiEye> eyes(names.size()) ;
+                    vector<bool> processed ;
+                    processEyes(names,eyes,processed) ;
+                    i = last - 1 ;
+                }
 
-                // Process a second eye if matching is requested
-                if ( mProcessMatching && (i<mListOfImages.size()-1) )
+                // Process the last eye alone
+                else if ( i==mListOfImages.size()-1 )
                 {
+                    OsiEye eye ;
+                    processOneEye(mListOfImages[i],eye) ;
+                }
+
+                // Get the templates of two eyes if matching is requested
+                else
+                {
+                    OsiIrisCode template1 , template2 ;
+                    getTemplate(mListOfImages[i],cache,template1) ;
                     i++ ;
                     cout << i+1 << " / " << mListOfImages.size() << endl ;
-                    OsiEye eye2 ;
-                    processOneEye(mListOfImages[i],eye2) ;
+                    getTemplate(mListOfImages[i],cache,template2) ;
 
-                    // Match the two iris codes
-                    float score = eye.match(eye2,mpApplicationPoints) ;
+                    // Match the two templates
+                    int shift ;
+                    float score = template1.match(template2,OSI_MAX_SHIFT,shift) ;
 
-                    // Save in file
+                    // Save in file (the file is flushed when it is closed, not for each pair)
                     if ( result_matching )
                     {                    
                         try
                         {
                             result_matching << mListOfImages[i-1] << " " ;
                             result_matching << mListOfImages[i] << " " ;
-                            result_matching << score << endl ;
+                            result_matching << score << "\n" ;
                         }
                         catch ( exception & e )
                         {
@@ -752,6 +1383,10 @@ namespace osiris
                             throw runtime_error("Error while saving result of matching in " + mOutputFileMatchingScores) ;
                         }
                     }
+                    if ( binary_matching.isOpened() )
+                    {
+                        binary_matching.write(i-1,i,score,shift) ;
+                    }
                 }
             }
 
@@ -762,17 +1397,460 @@ namespace osiris
 
         } // end for images
 
-        // If matching is requested, close the file
+        // If matching is requested, close the files
         if ( result_matching )
         {
             result_matching.close() ;
         }
+        binary_matching.close() ;
 
-        cout << endl ;
-        cout << "==============" << endl ;
-        cout << "End processing" << endl ;
-        cout << "==============" << endl ;
-        cout << endl ;
+        if ( mProcessMatching )
+        {
+            cout << endl ;
+            cout << "- Template cache : " << cache.getNumberOfHits() << " hits, " << cache.getNumberOfMisses() << " misses" << endl ;
+        }
+
+    } // end of function
+
+
+
+
+
+    // Get the template of an eye from the cache, or process the eye
+    void OsiManager::getTemplate ( const string & rFileName , OsiTemplateCache & rCache , OsiIrisCode & rTemplate )
+    {
+        if ( rCache.find(rFileName,rTemplate) )
+        {
+            return ;
+        }
+
+        // Not in cache : process the eye
+        OsiEye eye ;
+        processOneEye(rFileName,eye) ;
+        if ( eye.getTemplate().isEmpty() )
+        {
+            throw runtime_error("Cannot match " + rFileName + " because its template is neither computed nor loaded") ;
+        }
+
+        rTemplate = eye.getTemplate() ;
+        rCache.insert(rFileName,rTemplate) ;
+
+    } // end of function
+
+
+
+
+
+
+    // Identify all images of the list among the gallery
+    void OsiManager::runIdentification ( )
+    {
+        // Enroll the gallery images : they are processed only once
+        OsiGallery gallery ;
+        OsiGalleryIndex index ;
+        enrollGallery(gallery,index) ;
+
+        // Create a file for the results
+        ofstream result_identification ;
+        if ( mOutputFileIdentification != "" )
+        {
+            result_identification.open(mOutputFileIdentification.c_str(),ios::out) ;
+            if ( ! result_identification )
+            {
+                throw runtime_error("Cannot create the file for identification results : " + mOutputFileIdentification) ;
+            }
+        }
+
+        // Search the images of the list in the gallery, by batches : the gallery is scanned once per batch
+        int batch_size = max(mSizeOfProbeBatches,1) ;
+        for ( int first = 0 ; first < mListOfImages.size() ; first += batch_size )
+        {
+            int last = min(first+batch_size,(int)mListOfImages.size()) ;
+            vector<OsiIrisCode> probes ;
+            vector<int> images ;
+            for ( int i = first ; i < last ; i++ )
+            {
+                // Message on prompt command to know the progress
+                cout << i+1 << " / " << mListOfImages.size() << endl ;
+
+                try
+                {
+                    OsiEye eye ;
+                    processOneEye(mListOfImages[i],eye) ;
+                    if ( eye.getTemplate().isEmpty() )
+                    {
+                        throw runtime_error("Cannot identify " + mListOfImages[i] + " because its template is neither computed nor loaded") ;
+                    }
+                    probes.push_back(eye.getTemplate()) ;
+                    images.push_back(i) ;
+                }
+                catch ( exception & e )
+                {
+                    cout << e.what() << endl ;
+                }
+            }
+
+            try
+            {
+                // Best candidates
+                vector< vector<OsiCandidate> > candidates = identify(gallery,index,probes,mNumberOfCandidates) ;
+
+                // Save in file : probe, then identity and score of each candidate
+                for ( int p = 0 ; p < images.size() && result_identification ; p++ )
+                {
+                    result_identification << mListOfImages[images[p]] ;
+                    for ( int c = 0 ; c < candidates[p].size() ; c++ )
+                    {
+                        result_identification << " " << gallery.getId(candidates[p][c].mIndex) ;
+                        result_identification << " " << candidates[p][c].mScore ;
+                    }
+                    result_identification << endl ;
+                }
+            }
+            catch ( exception & e )
+            {
+                cout << e.what() << endl ;
+            }
+        }
+
+        // Close the file
+        if ( result_identification )
+        {
+            result_identification.close() ;
+        }
+
+    } // end of function
+
+
+
+
+
+
+    // Map the gallery file, process all images of the gallery list and enroll their templates
+    void OsiManager::enrollGallery ( OsiGallery & rGallery , OsiGalleryIndex & rIndex )
+    {
+        // Entries of a previous run, scanned directly in the file
+        if ( mInputFileGallery != "" )
+        {
+            rGallery.load(mInputFileGallery) ;
+            cout << "Gallery " << mInputFileGallery << " contains " << rGallery.getSize() << " eyes" << endl ;
+        }
+
+        // The eyes are processed by batches, and encoded together
+        int batch_size = max(mSizeOfEncodingBatches,1) ;
+        for ( int first = 0 ; first < mListOfGalleryImages.size() ; first += batch_size )
+        {
+            // Message on prompt command to know the progress
+            int last = min(first+batch_size,(int)mListOfGalleryImages.size()) ;
+            cout << "Enroll " << last << " / " << mListOfGalleryImages.size() << endl ;
+
+            vector<string> names(mListOfGalleryImages.begin()+first,mListOfGalleryImages.begin()+last) ;
+            vector<OsiEye> eyes(names.size()) ;
+            vector<bool> processed ;
+            processEyes(names,eyes,processed) ;
+            for ( int i = 0 ; i < names.size() ; i++ )
+            {
+                try
+                {
+                    if ( processed[i] )
+                    {
+                        rGallery.enroll(names[i],eyes[i].getTemplate()) ;
+                    }
+                }
+                catch ( exception & e )
+                {
+                    cout << e.what() << endl ;
+                }
+            }
+        }
+
+        // Save the gallery for the next runs
+        if ( mOutputFileGallery != "" )
+        {
+            rGallery.save(mOutputFileGallery) ;
+        }
+
+        // Index the gallery
+        if ( mUseGalleryIndex )
+        {
+            cout << "Index the gallery" << endl ;
+            if ( ! mpApplicationPoints )
+            {
+                throw runtime_error("Cannot index the gallery without application points") ;
+            }
+            rIndex.setParameters(mRadiusOfIndexSearch,mMinimumVotesOfIndexSearch) ;
+            rIndex.build(rGallery,OsiModelBundle::packPoints(mpApplicationPoints)) ;
+        }
+
+    } // end of function
+
+
+
+
+
+
+    // Search the closest entries of the gallery to a probe
+    vector<OsiCandidate> OsiManager::identify ( const OsiGallery & rGallery , const OsiGalleryIndex & rIndex , const OsiIrisCode & rProbe , int nCandidates )
+    {
+        if ( mUseGalleryIndex )
+        {
+            return rIndex.identify(rGallery,rProbe,nCandidates) ;
+        }
+        if ( mUseCascadeSearch )
+        {
+            return rGallery.identify(rProbe,nCandidates,getCascade(),mNumberOfThreads) ;
+        }
+        return rGallery.identify(rProbe,nCandidates,mNumberOfThreads) ;
+
+    } // end of function
+
+
+
+
+
+
+    // Search the closest entries of the gallery to several probes
+    vector< vector<OsiCandidate> > OsiManager::identify ( const OsiGallery & rGallery , const OsiGalleryIndex & rIndex , const vector<OsiIrisCode> & rProbes , int nCandidates )
+    {
+        if ( mUseGalleryIndex )
+        {
+            vector< vector<OsiCandidate> > candidates ;
+            for ( int p = 0 ; p < rProbes.size() ; p++ )
+            {
+                candidates.push_back(rIndex.identify(rGallery,rProbes[p],nCandidates)) ;
+            }
+            return candidates ;
+        }
+        if ( mUseCascadeSearch )
+        {
+            return rGallery.identify(rProbes,nCandidates,getCascade(),mNumberOfThreads,mSizeOfProbeBatches) ;
+        }
+        return rGallery.identify(rProbes,nCandidates,mNumberOfThreads,mSizeOfProbeBatches) ;
+
+    } // end of function
+
+
+
+
+
+
+    // Parameters of the coarse-to-fine search
+    OsiCascade OsiManager::getCascade ( ) const
+    {
+        return OsiCascade(mFirstFilterOfCascade,mNumberOfFiltersOfCascade,mRejectionThresholdOfCascade,mNumberOfSurvivorsOfCascade) ;
+
+    } // end of function
+
+
+
+
+
+
+    // Run a resident server answering requests over a local socket
+    void OsiManager::runServer ( )
+    {
+        // The gallery stays in memory between requests
+        OsiGallery gallery ;
+        OsiGalleryIndex index ;
+        enrollGallery(gallery,index) ;
+
+        OsiServer server ;
+        server.open(mServerSocket) ;
+        cout << "Server listening on " << mServerSocket << " with " << gallery.getSize() << " enrolled eyes" << endl ;
+
+        server.run([&](const string & rRequest)
+        {
+            return answerRequest(rRequest,gallery,index,server) ;
+        }) ;
+
+        server.close() ;
+
+    } // end of function
+
+
+
+
+
+
+    // Answer one request of the server
+    string OsiManager::answerRequest ( const string & rRequest , OsiGallery & rGallery , const OsiGalleryIndex & rIndex , OsiServer & rServer )
+    {
+        OsiStringUtils osu ;
+        istringstream request(rRequest) ;
+        ostringstream answer ;
+        string command ;
+        request >> command ;
+        command = osu.toUpper(command) ;
+
+        try
+        {
+            if ( command == "ENROLL" )
+            {
+                string id , name ;
+                if ( ! ( request >> id >> name ) )
+                {
+                    throw runtime_error("Usage : ENROLL id eye") ;
+                }
+                OsiEye eye ;
+                processOneEye(name,eye) ;
+                answer << "OK " << rGallery.enroll(id,eye.getTemplate()) ;
+            }
+
+            else if ( command == "VERIFY" )
+            {
+                string id , name , value ;
+                float threshold = mDecisionThreshold ;
+                if ( ! ( request >> id >> name ) )
+                {
+                    throw runtime_error("Usage : VERIFY id eye [threshold]") ;
+                }
+                if ( request >> value )
+                {
+                    istringstream parser(value) ;
+                    if ( ! ( parser >> threshold ) || ! parser.eof() || ! ( threshold >= 0 && threshold <= 1 ) )
+                    {
+                        throw runtime_error("Usage : VERIFY id eye [threshold], the threshold is between 0 and 1") ;
+                    }
+                }
+                OsiEye eye ;
+                processOneEye(name,eye) ;
+                if ( eye.getTemplate().isEmpty() )
+                {
+                    throw runtime_error("Cannot verify " + name + " because its template is neither computed nor loaded") ;
+                }
+                float score ;
+                bool accepted = rGallery.verify(id,eye.getTemplate(),threshold,score) ;
+                answer << ( accepted ? "ACCEPT " : "REJECT " ) << score ;
+            }
+
+            else if ( command == "IDENTIFY" )
+            {
+                string name , value ;
+                int n_candidates = mNumberOfCandidates ;
+                if ( ! ( request >> name ) )
+                {
+                    throw runtime_error("Usage : IDENTIFY eye [candidates]") ;
+                }
+                if ( request >> value )
+                {
+                    istringstream parser(value) ;
+                    if ( ! ( parser >> n_candidates ) || ! parser.eof() || n_candidates <= 0 )
+                    {
+                        throw runtime_error("Usage : IDENTIFY eye [candidates], the number of candidates is positive") ;
+                    }
+                }
+                OsiEye eye ;
+                processOneEye(name,eye) ;
+                if ( eye.getTemplate().isEmpty() )
+                {
+                    throw runtime_error("Cannot identify " + name + " because its template is neither computed nor loaded") ;
+                }
+                vector<OsiCandidate> candidates = identify(rGallery,rIndex,eye.getTemplate(),n_candidates) ;
+                answer << "OK" ;
+                for ( int c = 0 ; c < candidates.size() ; c++ )
+                {
+                    answer << " " << rGallery.getId(candidates[c].mIndex) << " " << candidates[c].mScore ;
+                }
+            }
+
+            else if ( command == "SAVE" )
+            {
+                if ( mOutputFileGallery == "" )
+                {
+                    throw runtime_error("Cannot save the gallery because no gallery file is configured") ;
+                }
+                rGallery.save(mOutputFileGallery) ;
+                answer << "OK " << rGallery.getSize() ;
+            }
+
+            else if ( command == "SHUTDOWN" )
+            {
+                rServer.stop() ;
+                answer << "OK" ;
+            }
+
+            else
+            {
+                throw runtime_error("Unknown request : " + rRequest) ;
+            }
+        }
+        catch ( exception & e )
+        {
+            answer.str("") ;
+            answer << "ERROR " << e.what() ;
+        }
+
+        cout << rRequest << " => " << answer.str() << endl ;
+
+        return answer.str() ;
+
+    } // end of function
+
+
+
+
+
+
+    // Match all images of the list against all images of the gallery (or against each other)
+    void OsiManager::runAllVsAll ( )
+    {
+        // Templates of all images are loaded once
+        vector<OsiIrisCode> probes , gallery ;
+        processTemplates(mListOfImages,probes) ;
+        if ( ! mListOfGalleryImages.empty() )
+        {
+            processTemplates(mListOfGalleryImages,gallery) ;
+        }
+
+        // Compute the matrix, symmetric if there is no gallery list
+        cout << "Compute the matrix of scores" << endl ;
+        OsiScoreMatrix matrix ;
+        if ( mListOfGalleryImages.empty() )
+        {
+            matrix.compute(probes,mNumberOfThreads,mSizeOfMatrixTiles) ;
+        }
+        else
+        {
+            matrix.compute(probes,gallery,mNumberOfThreads,mSizeOfMatrixTiles) ;
+        }
+
+        // Save the matrix
+        if ( mOutputFileMatrixOfScores != "" )
+        {
+            matrix.save(mOutputFileMatrixOfScores) ;
+        }
+
+    } // end of function
+
+
+
+
+
+    // Process all images of a list and keep their templates
+    void OsiManager::processTemplates ( const vector<string> & rList , vector<OsiIrisCode> & rTemplates )
+    {
+        rTemplates.assign(rList.size(),OsiIrisCode()) ;
+
+        for ( int i = 0 ; i < rList.size() ; i++ )
+        {
+            // Message on prompt command to know the progress
+            cout << i+1 << " / " << rList.size() << endl ;
+
+            try
+            {
+                OsiEye eye ;
+                processOneEye(rList[i],eye) ;
+                if ( eye.getTemplate().isEmpty() )
+                {
+                    throw runtime_error("Cannot match " + rList[i] + " because its template is neither computed nor loaded") ;
+                }
+                rTemplates[i] = eye.getTemplate() ;
+            }
+            catch ( exception & e )
+            {
+                cout << e.what() << endl ;
+            }
+        }
 
     } // end of function
 
@@ -14,6 +14,11 @@
 #include <map>
 #include "highgui.h"
 #include "OsiEye.h"
+#include "OsiGallery.h"
+#include "OsiGalleryIndex.h"
+#include "OsiScoreMatrix.h"
+#include "OsiServer.h"
+#include "OsiTemplateCache.h"
 
 
 namespace osiris
@@ -57,7 +62,7 @@ namespace osiris
 
         /** Run osiris according to the configuration.
         * Build the eyes and process them as requested by the configuration file.
-        * @see processOneEye()
+        * @see processOneEye() , processListOfImages() , runIdentification() , runAllVsAll() , runServer()
         */
         void run ( ) ;
 
@@ -69,17 +74,36 @@ namespace osiris
         bool mProcessNormalization ;
         bool mProcessEncoding ;
         bool mProcessMatching ;
+        bool mProcessIdentification ;
+        bool mProcessAllVsAll ;
+        bool mProcessServer ;
+        bool mProcessConversionOfScores ;
         bool mUseMask ;
+        bool mUseGalleryIndex ;
+        bool mUseCascadeSearch ;
+        bool mCompressMasksOfCodeArchive ;
+        bool mUseFourierEncoding ;
+        bool mEncodeOnlyApplicationPoints ;
+        bool mUseFixedPointEncoding ;
+        bool mUseDefaultModel ;
+        bool mUseBilinearNormalization ;
 
         // Inputs
         std::string mFilenameListOfImages ;
         std::vector<std::string> mListOfImages ;
+        std::string mFilenameListOfGalleryImages ;
+        std::vector<std::string> mListOfGalleryImages ;
         std::string mInputDirOriginalImages ;
         std::string mInputDirMasks ;
         std::string mInputDirParameters ;
         std::string mInputDirNormalizedImages ;
         std::string mInputDirNormalizedMasks ;
         std::string mInputDirIrisCodes ;
+        std::string mInputDirTemplates ;
+        std::string mInputFileGallery ;
+        std::string mInputFileBinaryScores ;
+        std::string mInputFileCodeArchive ;
+        std::string mInputFileModelBundle ;
 
         // Outputs
         std::string mOutputDirSegmentedImages ;
@@ -88,7 +112,15 @@ namespace osiris
         std::string mOutputDirNormalizedImages ;
         std::string mOutputDirNormalizedMasks ;
         std::string mOutputDirIrisCodes ;
+        std::string mOutputDirTemplates ;
         std::string mOutputFileMatchingScores ;
+        std::string mOutputFileBinaryScores ;
+        std::string mOutputFileIdentification ;
+        std::string mOutputFileMatrixOfScores ;
+        std::string mOutputFileGallery ;
+        std::string mOutputFileCodeArchive ;
+        std::string mOutputFileModelBundle ;
+        std::string mServerSocket ;
 
         // Parameters
         int mMinPupilDiameter ;
@@ -99,8 +131,27 @@ namespace osiris
         int mHeightOfNormalizedIris ;
         std::string mFilenameGaborFilters ;
         std::vector<CvMat*> mGaborFilters ;
+        OsiFilterSpectra mGaborSpectra ;
+        OsiSeparableFilters mSeparableGaborFilters ;
+        OsiFixedPointFilters mFixedPointGaborFilters ;
+        int mRankOfSeparableFilters ;
+        float mMinimumAgreementWithDenseFilters ;
         std::string mFilenameApplicationPoints ;
         CvMat* mpApplicationPoints ;
+        int mNumberOfCandidates ;
+        int mSizeOfTemplateCache ;
+        int mNumberOfThreads ;
+        int mSizeOfMatrixTiles ;
+        int mSizeOfProbeBatches ;
+        int mSizeOfEncodingBatches ;
+        float mDecisionThreshold ;
+        int mRadiusOfIndexSearch ;
+        int mMinimumVotesOfIndexSearch ;
+        int mFirstFilterOfCascade ;
+        int mNumberOfFiltersOfCascade ;
+        float mRejectionThresholdOfCascade ;
+        int mNumberOfSurvivorsOfCascade ;
+        std::string mHammingKernel ;
 
         // Suffix for filenames
         std::string mSuffixSegmentedImages ;
@@ -109,10 +160,16 @@ namespace osiris
         std::string mSuffixNormalizedImages ;
         std::string mSuffixNormalizedMasks ;
         std::string mSuffixIrisCodes ;
+        std::string mSuffixTemplates ;
+
+        // Archives of iris codes, opened during run()
+        OsiCodeArchive mInputCodeArchive ;
+        OsiCodeArchive mOutputCodeArchive ;
 
         // Maps to associate a string (conf file) to a variable (not the value of the variable !)
         std::map<std::string,bool*> mMapBool ;
         std::map<std::string,int*> mMapInt ;
+        std::map<std::string,float*> mMapFloat ;
         std::map<std::string,std::string*> mMapString ;
 
 
@@ -132,8 +189,8 @@ namespace osiris
         * - Application points matrix is blank
         * - All commands of processing are set to false => nothing is going to be executed
         * - Suffix for filenames are ""_segm.bmp", "_para.txt", "_mask.bmp", "_imno.bmp",
-        * "_mano.bmp", and "_code.bmp" respectively for segmented image, parameters, mask, 
-        * normalized image, normalized mask, iris code
+        * "_mano.bmp", "_code.bmp" and "_tmpl.bin" respectively for segmented image, parameters, mask, 
+        * normalized image, normalized mask, iris code, template
         * @see loadConfiguration()
         * @see showConfiguration()
         */
@@ -146,8 +203,10 @@ namespace osiris
         * For matching lists, it may be more readable to present the list
         * on two columns of names. For other process (segmentation, normalization,
         * encoding), it is more readable to present only one column.
+        * @param rFilename The textfile containing the list
+        * @param rList The list of images. Filled by the function
         */
-        void loadListOfImages ( ) ;
+        void loadListOfImages ( const std::string & rFilename , std::vector<std::string> & rList ) ;
 
         /** Load the Gabor filters.
         * The coefficient of Gabor filters are stored in a textfile
@@ -164,6 +223,14 @@ namespace osiris
         */
         void loadApplicationPoints ( ) ;
 
+        /** Load the Gabor filters and the application points from a binary model bundle.
+        * The bundle is the file of the configuration, or the default one compiled into Osiris.
+        * @param filters Load the Gabor filters
+        * @param points Load the application points, which must fit the size of normalized iris
+        * @see OsiModelBundle
+        */
+        void loadModelBundle ( bool filters , bool points ) ;
+
         /** Load, segment, normalize, encode, and save according to user configuration.        
         * @param rName The eye name (used to name the loading/saving files)
         * @param rEye The eye to be processed
@@ -172,6 +239,140 @@ namespace osiris
         */
         void processOneEye ( const std::string & rName , OsiEye & rEye ) ;
 
+        /** Process several eyes, as processOneEye() does for each eye.
+        * The eyes are encoded together if the dense Gabor filters are used, by several threads.
+        * The errors are displayed, the eyes whose processing fails are skipped by the next steps.
+        * @param rNames The eye names (used to name the loading/saving files)
+        * @param rEyes The eyes to be processed, one per name
+        * @param rProcessed For each eye, true if all the steps succeeded. Filled by the function
+        * @return void
+        * @see processOneEye() , OsiEye::encode()
+        */
+        void processEyes ( const std::vector<std::string> & rNames , std::vector<OsiEye> & rEyes , std::vector<bool> & rProcessed ) ;
+
+        /** Load, segment and normalize according to user configuration : first steps of processOneEye().
+        * @param rName The eye name (used to name the loading/saving files)
+        * @param rEye The eye to be processed
+        * @return void
+        */
+        void prepareEye ( const std::string & rName , OsiEye & rEye ) ;
+
+        /** Encode according to user configuration : encoding step of processOneEye().
+        * @param rName The eye name (used to name the loading/saving files)
+        * @param rEye The eye to be processed
+        * @return void
+        */
+        void encodeEye ( const std::string & rName , OsiEye & rEye ) ;
+
+        /** Load the iris code, extract the template and save according to user configuration :
+        * last steps of processOneEye().
+        * @param rName The eye name (used to name the loading/saving files)
+        * @param rEye The eye to be processed
+        * @return void
+        */
+        void finishEye ( const std::string & rName , OsiEye & rEye ) ;
+
+        /** Get the template of an eye from the cache.
+        * If the eye is not in the cache, it is processed by processOneEye() and its template is cached.
+        * @param rName The eye name (used to name the loading/saving files)
+        * @param rCache The cache of templates
+        * @param rTemplate The template of the eye. Filled by the function
+        * @return void
+        * @see processOneEye() , OsiTemplateCache
+        */
+        void getTemplate ( const std::string & rName , OsiTemplateCache & rCache , OsiIrisCode & rTemplate ) ;
+
+        /** Process all images of the list.
+        * If matching is requested, images are processed two by two and their templates are matched.
+        * Templates are kept in a cache, so that an image appearing in several pairs is processed once.
+        * @see processOneEye() , getTemplate()
+        */
+        void processListOfImages ( ) ;
+
+        /** Identify all images of the list among the gallery.
+        * The gallery images are processed once and their templates are kept in memory.
+        * Then the images of the list are processed and searched in the gallery by batches.
+        * @see processOneEye() , OsiGallery::identify()
+        */
+        void runIdentification ( ) ;
+
+        /** Build the gallery : map the gallery file if any, then process all images
+        * of the gallery list and enroll their templates. The gallery is saved if requested,
+        * and indexed if requested.
+        * @param rGallery The gallery. Filled by the function
+        * @param rIndex The index of the gallery. Filled by the function
+        * @return void
+        * @see processOneEye() , OsiGallery::enroll() , OsiGalleryIndex::build()
+        */
+        void enrollGallery ( OsiGallery & rGallery , OsiGalleryIndex & rIndex ) ;
+
+        /** Search the closest entries of the gallery to a probe, with the index or the cascade if requested.
+        * @param rGallery The gallery
+        * @param rIndex The index of the gallery
+        * @param rProbe The template of the probe
+        * @param nCandidates The maximum number of candidates to return
+        * @return The best candidates, sorted by increasing score
+        * @see OsiGallery::identify() , OsiGalleryIndex::identify()
+        */
+        std::vector<OsiCandidate> identify ( const OsiGallery & rGallery , const OsiGalleryIndex & rIndex , const OsiIrisCode & rProbe , int nCandidates ) ;
+
+        /** Search the closest entries of the gallery to several probes, with the index or the cascade if requested.
+        * Without index, the gallery is scanned once for each batch of "Size of probe batches" probes.
+        * @param rGallery The gallery
+        * @param rIndex The index of the gallery
+        * @param rProbes The templates of the probes
+        * @param nCandidates The maximum number of candidates to return for each probe
+        * @return The best candidates of each probe, sorted by increasing score
+        * @see OsiGallery::identify() , OsiGalleryIndex::identify()
+        */
+        std::vector< std::vector<OsiCandidate> > identify ( const OsiGallery & rGallery , const OsiGalleryIndex & rIndex , const std::vector<OsiIrisCode> & rProbes , int nCandidates ) ;
+
+        /** Get the parameters of the coarse-to-fine search from the configuration.
+        * @return The band and the cut-offs of the first stage
+        * @see OsiGallery::identify()
+        */
+        OsiCascade getCascade ( ) const ;
+
+        /** Run a resident server answering requests over a local socket.
+        * The filters, application points and gallery stay in memory between requests.
+        * The gallery list, if any, is enrolled at start-up. Requests are lines of text,
+        * eyes being named as in the lists of images :
+        * - ENROLL id eye : answer "OK index"
+        * - VERIFY id eye [threshold] : answer "ACCEPT score" or "REJECT score"
+        * - IDENTIFY eye [candidates] : answer "OK" followed by the identity and score of each candidate
+        * - SAVE : save the gallery into the gallery file, answer "OK size"
+        * - SHUTDOWN : answer "OK" and stop the server
+        *
+        * An error gives the answer "ERROR" followed by the message.
+        * @see answerRequest() , OsiServer
+        */
+        void runServer ( ) ;
+
+        /** Answer one request of the server.
+        * @param rRequest The request line
+        * @param rGallery The gallery
+        * @param rIndex The index of the gallery
+        * @param rServer The server, stopped on SHUTDOWN request
+        * @return The answer line
+        * @see runServer()
+        */
+        std::string answerRequest ( const std::string & rRequest , OsiGallery & rGallery , const OsiGalleryIndex & rIndex , OsiServer & rServer ) ;
+
+        /** Match all images of the list against all images of the gallery list.
+        * If there is no gallery list, all images of the list are matched against each other.
+        * All templates are loaded once, then the matrix of scores is computed and saved.
+        * @see processOneEye() , OsiScoreMatrix
+        */
+        void runAllVsAll ( ) ;
+
+        /** Process all images of a list and keep their templates.
+        * @param rList The list of images
+        * @param rTemplates The templates, empty for the images that cannot be processed. Filled by the function
+        * @return void
+        * @see processOneEye()
+        */
+        void processTemplates ( const std::vector<std::string> & rList , std::vector<OsiIrisCode> & rTemplates ) ;
+
     } ; // End of class
 
 } // End of namespace
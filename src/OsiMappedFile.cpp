@@ -0,0 +1,189 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <fstream>
+#include <stdexcept>
+#include "OsiMappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // Table of the CRC-32 (polynomial 0xEDB88320) for each byte value
+    struct ChecksumTable
+    {
+        uint32_t mValues [256] ;
+
+        ChecksumTable ( )
+        {
+            for ( uint32_t i = 0 ; i < 256 ; i++ )
+            {
+                uint32_t c = i ;
+                for ( int k = 0 ; k < 8 ; k++ )
+                {
+                    c = ( c & 1 ) ? 0xEDB88320U ^ ( c >> 1 ) : ( c >> 1 ) ;
+                }
+                mValues[i] = c ;
+            }
+        }
+    } ;
+
+
+
+
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiMappedFile::OsiMappedFile ( )
+    {
+        mpData = 0 ;
+        mSize = 0 ;
+        mMapped = false ;
+    }
+
+    OsiMappedFile::~OsiMappedFile ( )
+    {
+        close() ;
+    }
+
+
+
+
+
+    // OPERATORS
+    ////////////
+
+    void OsiMappedFile::open ( const string & rFilename )
+    {
+        close() ;
+
+#ifndef _WIN32
+
+        int file = ::open(rFilename.c_str(),O_RDONLY) ;
+        if ( file < 0 )
+        {
+            throw runtime_error("Cannot open the file " + rFilename) ;
+        }
+
+        struct stat status ;
+        if ( fstat(file,&status) < 0 )
+        {
+            ::close(file) ;
+            throw runtime_error("Cannot get the size of the file " + rFilename) ;
+        }
+        mSize = status.st_size ;
+
+        // An empty file cannot be mapped
+        if ( mSize )
+        {
+            void * p_data = mmap(0,mSize,PROT_READ,MAP_SHARED,file,0) ;
+            if ( p_data == MAP_FAILED )
+            {
+                ::close(file) ;
+                mSize = 0 ;
+                throw runtime_error("Cannot map the file " + rFilename) ;
+            }
+            mpData = (const char*)p_data ;
+        }
+
+        // The mapping stays valid after closing the file
+        ::close(file) ;
+
+#else
+
+        // Read the whole file
+        ifstream file(rFilename.c_str(),ios::in|ios::binary) ;
+        if ( ! file )
+        {
+            throw runtime_error("Cannot open the file " + rFilename) ;
+        }
+        file.seekg(0,ios::end) ;
+        mSize = (size_t)file.tellg() ;
+        file.seekg(0,ios::beg) ;
+        mBuffer.resize(mSize) ;
+        if ( mSize && ! file.read(&mBuffer[0],mSize) )
+        {
+            mBuffer.clear() ;
+            mSize = 0 ;
+            throw runtime_error("Cannot read the file " + rFilename) ;
+        }
+        mpData = mSize ? &mBuffer[0] : 0 ;
+
+#endif
+
+        mMapped = true ;
+    }
+
+
+
+    void OsiMappedFile::close ( )
+    {
+        if ( ! mMapped )
+        {
+            return ;
+        }
+
+#ifndef _WIN32
+        if ( mpData )
+        {
+            munmap((void*)mpData,mSize) ;
+        }
+#else
+        mBuffer.clear() ;
+#endif
+
+        mpData = 0 ;
+        mSize = 0 ;
+        mMapped = false ;
+    }
+
+
+
+    bool OsiMappedFile::isOpened ( ) const
+    {
+        return mMapped ;
+    }
+
+
+
+    const char * OsiMappedFile::getData ( ) const
+    {
+        return mpData ;
+    }
+
+
+
+    size_t OsiMappedFile::getSize ( ) const
+    {
+        return mSize ;
+    }
+
+
+
+    uint32_t OsiMappedFile::computeChecksum ( const char * pData , size_t size )
+    {
+        static const ChecksumTable table ;
+        uint32_t crc = 0xFFFFFFFFU ;
+        for ( size_t i = 0 ; i < size ; i++ )
+        {
+            crc = table.mValues[ ( crc ^ (unsigned char)pData[i] ) & 0xFF ] ^ ( crc >> 8 ) ;
+        }
+        return crc ^ 0xFFFFFFFFU ;
+    }
+
+} // end of namespace
+
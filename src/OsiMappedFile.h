@@ -0,0 +1,94 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_MAPPED_FILE_H
+#define OSI_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace osiris
+{
+
+    /** Read-only file mapped in memory.
+    * The file is mapped with mmap on POSIX systems : its pages are loaded on demand
+    * and shared with the system cache. On other systems, the file is read into memory.
+    * The data is aligned on at least 8 bytes.
+    * @see OsiGallery
+    */
+    class OsiMappedFile
+    {
+
+    public :
+
+        /** Default constructor. */
+        OsiMappedFile ( ) ;
+
+        /** Default destructor. Unmap the file. */
+        ~OsiMappedFile ( ) ;
+
+        /** Map a file in memory.
+        * @param rFilename Complete path of the file
+        * @return void
+        */
+        void open ( const std::string & rFilename ) ;
+
+        /** Unmap the file.
+        * @return void
+        */
+        void close ( ) ;
+
+        /** Check if a file is mapped.
+        * @return true if a file is mapped
+        */
+        bool isOpened ( ) const ;
+
+        /** Get the content of the file.
+        * @return A pointer on the first byte
+        */
+        const char * getData ( ) const ;
+
+        /** Get the size of the file.
+        * @return The size in bytes
+        */
+        size_t getSize ( ) const ;
+
+        /** Compute the CRC-32 of some bytes (polynomial 0xEDB88320, as zlib).
+        * @param pData The first byte
+        * @param size The number of bytes
+        * @return The checksum
+        */
+        static uint32_t computeChecksum ( const char * pData , size_t size ) ;
+
+    private :
+
+        /** The content of the file. */
+        const char * mpData ;
+
+        /** The size of the file. */
+        size_t mSize ;
+
+        /** The content of the file, when it cannot be mapped. */
+        std::vector<char> mBuffer ;
+
+        /** Is the file mapped (or read into the buffer). */
+        bool mMapped ;
+
+        /** A mapped file cannot be copied. */
+        OsiMappedFile ( const OsiMappedFile & ) ;
+        OsiMappedFile & operator = ( const OsiMappedFile & ) ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
@@ -0,0 +1,302 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "OsiModelBundle.h"
+#include "OsiDefaultModel.h"
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // Size of the header, before the payload
+    static const size_t HEADER_SIZE = 16 ;
+
+
+
+    // Offset of the next block aligned on 32 bytes
+    static size_t align ( size_t offset )
+    {
+        return ( offset + 31 ) / 32 * 32 ;
+    }
+
+
+
+    // Write a value into a buffer of bytes
+    static void writeValue ( vector<char> & rBuffer , size_t offset , int32_t value )
+    {
+        memcpy(&rBuffer[offset],&value,sizeof(value)) ;
+    }
+
+
+
+
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiModelBundle::OsiModelBundle ( )
+    {
+        mpData = 0 ;
+        mSize = 0 ;
+    }
+
+    OsiModelBundle::~OsiModelBundle ( )
+    {
+        close() ;
+    }
+
+
+
+
+
+    // OPERATORS
+    ////////////
+
+    void OsiModelBundle::open ( const string & rFilename )
+    {
+        close() ;
+        mFile.open(rFilename) ;
+        try
+        {
+            check(mFile.getData(),mFile.getSize(),rFilename) ;
+        }
+        catch ( ... )
+        {
+            mFile.close() ;
+            throw ;
+        }
+    }
+
+
+
+    void OsiModelBundle::openDefault ( )
+    {
+        close() ;
+        check((const char*)DefaultModel,sizeof(DefaultModel),"the default model bundle") ;
+    }
+
+
+
+    void OsiModelBundle::close ( )
+    {
+        mFile.close() ;
+        mpData = 0 ;
+        mSize = 0 ;
+    }
+
+
+
+    bool OsiModelBundle::isOpened ( ) const
+    {
+        return mpData != 0 ;
+    }
+
+
+
+    int OsiModelBundle::getNumberOfFilters ( ) const
+    {
+        return getValue(0) ;
+    }
+
+
+
+    void OsiModelBundle::getFilters ( vector<CvMat*> & rFilters ) const
+    {
+        for ( int f = 0 ; f < getNumberOfFilters() ; f++ )
+        {
+            int rows = getValue(4+4*f) ;
+            int cols = getValue(5+4*f) ;
+            const char * p_taps = mpData + getValue(6+4*f) ;
+            CvMat * p_filter = cvCreateMat(rows,cols,CV_32FC1) ;
+            for ( int i = 0 ; i < rows ; i++ )
+            {
+                memcpy(p_filter->data.ptr+i*p_filter->step,p_taps+i*cols*sizeof(float),cols*sizeof(float)) ;
+            }
+            rFilters.push_back(p_filter) ;
+        }
+    }
+
+
+
+    int OsiModelBundle::getWidth ( ) const
+    {
+        return getValue(1) ;
+    }
+
+
+
+    int OsiModelBundle::getHeight ( ) const
+    {
+        return getValue(2) ;
+    }
+
+
+
+    const uint64_t * OsiModelBundle::getPoints ( int row ) const
+    {
+        return (const uint64_t*)(mpData+getValue(3)) + row * ( ( getWidth() + 63 ) / 64 ) ;
+    }
+
+
+
+    CvMat * OsiModelBundle::getApplicationPoints ( ) const
+    {
+        CvMat * p_points = cvCreateMat(getHeight(),getWidth(),CV_8UC1) ;
+        cvZero(p_points) ;
+        for ( int i = 0 ; i < getHeight() ; i++ )
+        {
+            const uint64_t * p_row = getPoints(i) ;
+            for ( int j = 0 ; j < getWidth() ; j++ )
+            {
+                if ( ( p_row[j/64] >> (j%64) ) & 1 )
+                {
+                    p_points->data.ptr[i*p_points->step+j] = 255 ;
+                }
+            }
+        }
+        return p_points ;
+    }
+
+
+
+    vector<uint64_t> OsiModelBundle::packPoints ( const CvMat * pApplicationPoints )
+    {
+        int words = ( pApplicationPoints->cols + 63 ) / 64 ;
+        vector<uint64_t> points(pApplicationPoints->rows*words,0) ;
+        for ( int i = 0 ; i < pApplicationPoints->rows ; i++ )
+        {
+            for ( int j = 0 ; j < pApplicationPoints->cols ; j++ )
+            {
+                if ( pApplicationPoints->data.ptr[i*pApplicationPoints->step+j] )
+                {
+                    points[i*words+j/64] |= (uint64_t) 1 << (j%64) ;
+                }
+            }
+        }
+        return points ;
+    }
+
+
+
+    void OsiModelBundle::save ( const string & rFilename , const vector<CvMat*> & rFilters ,
+                                const CvMat * pApplicationPoints )
+    {
+        int n_filters = rFilters.size() ;
+        int width = pApplicationPoints->cols ;
+        int height = pApplicationPoints->rows ;
+        int words = ( width + 63 ) / 64 ;
+
+        // Place the blocks : descriptors, taps of each filter, points
+        vector<size_t> offsets(n_filters) ;
+        size_t size = HEADER_SIZE + 16 + 16 * n_filters ;
+        for ( int f = 0 ; f < n_filters ; f++ )
+        {
+            offsets[f] = align(size) ;
+            size = offsets[f] + rFilters[f]->rows * rFilters[f]->cols * sizeof(float) ;
+        }
+        size_t points_offset = align(size) ;
+        size = points_offset + height * words * sizeof(uint64_t) ;
+
+        // Payload
+        vector<char> buffer(size,0) ;
+        writeValue(buffer,HEADER_SIZE,n_filters) ;
+        writeValue(buffer,HEADER_SIZE+4,width) ;
+        writeValue(buffer,HEADER_SIZE+8,height) ;
+        writeValue(buffer,HEADER_SIZE+12,points_offset) ;
+        for ( int f = 0 ; f < n_filters ; f++ )
+        {
+            const CvMat * p_filter = rFilters[f] ;
+            writeValue(buffer,HEADER_SIZE+16+16*f,p_filter->rows) ;
+            writeValue(buffer,HEADER_SIZE+20+16*f,p_filter->cols) ;
+            writeValue(buffer,HEADER_SIZE+24+16*f,offsets[f]) ;
+            for ( int i = 0 ; i < p_filter->rows ; i++ )
+            {
+                memcpy(&buffer[offsets[f]+i*p_filter->cols*sizeof(float)],p_filter->data.ptr+i*p_filter->step,p_filter->cols*sizeof(float)) ;
+            }
+        }
+        vector<uint64_t> points = packPoints(pApplicationPoints) ;
+        memcpy(&buffer[points_offset],&points[0],points.size()*sizeof(uint64_t)) ;
+
+        // Header
+        memcpy(&buffer[0],"OSIB",4) ;
+        writeValue(buffer,4,1) ;
+        writeValue(buffer,8,size-HEADER_SIZE) ;
+        uint32_t checksum = OsiMappedFile::computeChecksum(&buffer[HEADER_SIZE],size-HEADER_SIZE) ;
+        memcpy(&buffer[12],&checksum,sizeof(checksum)) ;
+
+        ofstream file(rFilename.c_str(),ios::out|ios::binary) ;
+        if ( ! file || ! file.write(&buffer[0],size) )
+        {
+            throw runtime_error("Cannot save the model bundle in " + rFilename) ;
+        }
+    }
+
+
+
+    void OsiModelBundle::check ( const char * pData , size_t size , const string & rName )
+    {
+        // Header
+        int32_t values[3] = { 0 , 0 , 0 } ;
+        uint32_t checksum = 0 ;
+        if ( size >= HEADER_SIZE + 16 && ! memcmp(pData,"OSIB",4) )
+        {
+            memcpy(values,pData,sizeof(values)) ;
+            memcpy(&checksum,pData+12,sizeof(checksum)) ;
+        }
+        if ( values[1] != 1 )
+        {
+            throw runtime_error("Unknown format or version of the model bundle in " + rName) ;
+        }
+        if ( values[2] < 16 || HEADER_SIZE + values[2] > size ||
+             OsiMappedFile::computeChecksum(pData+HEADER_SIZE,values[2]) != checksum )
+        {
+            throw runtime_error("The model bundle in " + rName + " is truncated or corrupted") ;
+        }
+        mpData = pData ;
+        mSize = HEADER_SIZE + values[2] ;
+
+        // Blocks must fit in the payload
+        int n_filters = getValue(0) ;
+        int width = getValue(1) ;
+        int height = getValue(2) ;
+        bool valid = ( n_filters >= 0 && width > 0 && height > 0 &&
+                       HEADER_SIZE + 16 + 16 * (uint64_t)n_filters <= mSize ) ;
+        for ( int f = 0 ; valid && f < n_filters ; f++ )
+        {
+            int64_t rows = getValue(4+4*f) ;
+            int64_t cols = getValue(5+4*f) ;
+            int64_t offset = getValue(6+4*f) ;
+            valid = ( rows > 0 && cols > 0 && offset >= 0 && offset % sizeof(float) == 0 &&
+                      offset + rows * cols * (int64_t)sizeof(float) <= (int64_t)mSize ) ;
+        }
+        int64_t points_offset = getValue(3) ;
+        valid = valid && ( points_offset >= 0 && points_offset % sizeof(uint64_t) == 0 &&
+                           points_offset + (int64_t)height * ( ( width + 63 ) / 64 ) * (int64_t)sizeof(uint64_t) <= (int64_t)mSize ) ;
+        if ( ! valid )
+        {
+            mpData = 0 ;
+            mSize = 0 ;
+            throw runtime_error("The model bundle in " + rName + " has invalid blocks") ;
+        }
+    }
+
+
+
+    int32_t OsiModelBundle::getValue ( int index ) const
+    {
+        int32_t value ;
+        memcpy(&value,mpData+HEADER_SIZE+index*sizeof(int32_t),sizeof(value)) ;
+        return value ;
+    }
+
+} // end of namespace
+
@@ -0,0 +1,153 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_MODEL_BUNDLE_H
+#define OSI_MODEL_BUNDLE_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "highgui.h"
+#include "OsiMappedFile.h"
+
+namespace osiris
+{
+
+    /** Binary bundle of the model : Gabor filters and application points.
+    * The bundle replaces the textfiles of filters and points, which are parsed one number at
+    * a time : it is mapped in memory and its values are used as they are. A default bundle,
+    * built from the parameters shipped with OSIRIS (data/OsirisParam, normalized iris of
+    * 512 x 64), is compiled into the program.\n
+    * Format (little-endian) :
+    * - header of 16 bytes : "OSIB", version (int32, 1), size of the payload (int32),
+    * CRC-32 of the payload (uint32)
+    * - payload : number of filters, width and height of the normalized iris, offset of the
+    * points (4 x int32), then rows, cols and offset of the taps of each filter, and 0 (4 x int32)
+    * - taps of each filter (float, row by row), aligned on 32 bytes
+    * - application points, aligned on 32 bytes : (width+63)/64 words of 64 bits for each row,
+    * bit j%64 of word j/64 is set at column j
+    *
+    * All offsets are counted from the first byte of the file.
+    * @see OsiManager , OsiMappedFile
+    */
+    class OsiModelBundle
+    {
+
+    public :
+
+        /** Default constructor. */
+        OsiModelBundle ( ) ;
+
+        /** Default destructor. Unmap the bundle. */
+        ~OsiModelBundle ( ) ;
+
+        /** Map a bundle and check its version and checksum.
+        * @param rFilename Complete path of the bundle
+        * @return void
+        */
+        void open ( const std::string & rFilename ) ;
+
+        /** Use the bundle compiled into the program.
+        * @return void
+        */
+        void openDefault ( ) ;
+
+        /** Unmap the bundle.
+        * @return void
+        */
+        void close ( ) ;
+
+        /** Check if a bundle is opened.
+        * @return true if a bundle is opened
+        */
+        bool isOpened ( ) const ;
+
+        /** Get the number of filters.
+        * @return The number of Gabor filters of the bundle
+        */
+        int getNumberOfFilters ( ) const ;
+
+        /** Copy the filters into matrices.
+        * @param rFilters The bank of Gabor filters, filled with new matrices (CV_32FC1)
+        * @return void
+        */
+        void getFilters ( std::vector<CvMat*> & rFilters ) const ;
+
+        /** Get the width of the normalized iris of the application points.
+        * @return The number of columns
+        */
+        int getWidth ( ) const ;
+
+        /** Get the height of the normalized iris of the application points.
+        * @return The number of rows
+        */
+        int getHeight ( ) const ;
+
+        /** Get the packed application points of a row.
+        * @param row The row of the normalized iris
+        * @return (getWidth()+63)/64 words, bit j%64 of word j/64 is set at column j
+        */
+        const uint64_t * getPoints ( int row ) const ;
+
+        /** Build the binary matrix of the application points.
+        * @return A new matrix of getHeight() x getWidth() (CV_8UC1), 255 at the points
+        */
+        CvMat * getApplicationPoints ( ) const ;
+
+        /** Pack a binary matrix of application points, as they are stored in a bundle.
+        * @param pApplicationPoints The binary matrix of the application points
+        * @return (width+63)/64 words for each row, bit j%64 of word j/64 is set at column j
+        * @see getPoints()
+        */
+        static std::vector<uint64_t> packPoints ( const CvMat * pApplicationPoints ) ;
+
+        /** Write a bundle.
+        * @param rFilename Complete path of the bundle
+        * @param rFilters The bank of Gabor filters (CV_32FC1)
+        * @param pApplicationPoints The binary matrix of the application points
+        * @return void
+        */
+        static void save ( const std::string & rFilename , const std::vector<CvMat*> & rFilters ,
+                           const CvMat * pApplicationPoints ) ;
+
+    private :
+
+        /** The mapped bundle. */
+        OsiMappedFile mFile ;
+
+        /** The content of the bundle, mapped or compiled into the program. */
+        const char * mpData ;
+
+        /** The size of the bundle. */
+        size_t mSize ;
+
+        /** Check the header and the offsets of a bundle, before using it.
+        * @param pData The content of the bundle
+        * @param size The size of the bundle
+        * @param rName The name of the bundle, for the messages
+        * @return void
+        */
+        void check ( const char * pData , size_t size , const std::string & rName ) ;
+
+        /** Get a value of the payload.
+        * @param index The index of the value (int32)
+        * @return The value
+        */
+        int32_t getValue ( int index ) const ;
+
+        /** A bundle cannot be copied. */
+        OsiModelBundle ( const OsiModelBundle & ) ;
+        OsiModelBundle & operator = ( const OsiModelBundle & ) ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
@@ -0,0 +1,261 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+#include "OsiHamming.h"
+#include "OsiProbe.h"
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiProbe::OsiProbe ( )
+    {
+        mMaxShift = 0 ;
+    }
+
+    OsiProbe::OsiProbe ( const OsiIrisCode & rCode , int maxShift )
+    {
+        create(rCode,maxShift) ;
+    }
+
+    OsiProbe::~OsiProbe ( )
+    {
+        // Do nothing
+    }
+
+
+
+
+
+    // OPERATORS
+    ////////////
+
+    void OsiProbe::create ( const OsiIrisCode & rCode , int maxShift )
+    {
+        if ( rCode.isEmpty() )
+        {
+            throw runtime_error("Cannot build the probe because its packed iris code is empty") ;
+        }
+
+        mCode = rCode ;
+        mMaxShift = maxShift ;
+
+        int n_words = mCode.getNumberOfWords() ;
+        int n_rows = mCode.getHeight() ;
+        int n_filters = mCode.getNumberOfFilters() ;
+        mShifts.resize((size_t)(2*mMaxShift+1)*n_filters*n_rows*n_words) ;
+
+        // Shifted rows are stored one after the other
+        uint64_t * p_row = &mShifts[0] ;
+        for ( int s = -mMaxShift ; s <= mMaxShift ; s++ )
+        {
+            for ( int f = 0 ; f < n_filters ; f++ )
+            {
+                for ( int r = 0 ; r < n_rows ; r++ )
+                {
+                    mCode.getShiftedCodeRow(f,r,s,p_row) ;
+                    p_row += n_words ;
+                }
+            }
+        }
+    }
+
+
+
+    const OsiIrisCode & OsiProbe::getCode ( ) const
+    {
+        return mCode ;
+    }
+
+
+
+
+
+    // Functions for matching
+    /////////////////////////
+
+    float OsiProbe::match ( const OsiIrisCode & rCode ) const
+    {
+        checkTemplate(rCode) ;
+        return match(rCode.getData()) ;
+    }
+
+
+
+    bool OsiProbe::verify ( const OsiIrisCode & rCode , float threshold , float & rScore ) const
+    {
+        checkTemplate(rCode) ;
+        return verify(rCode.getData(),threshold,rScore) ;
+    }
+
+
+
+    float OsiProbe::match ( const uint64_t * pRecord ) const
+    {
+        return match(pRecord,0,mCode.getNumberOfFilters()) ;
+    }
+
+
+
+    bool OsiProbe::verify ( const uint64_t * pRecord , float threshold , float & rScore ) const
+    {
+        return verify(pRecord,0,mCode.getNumberOfFilters(),threshold,rScore) ;
+    }
+
+
+
+    float OsiProbe::match ( const uint64_t * pRecord , int firstFilter , int nFilters ) const
+    {
+        double total = countValidBits(pRecord) * nFilters ;
+
+        // The minimum score will be returned
+        float score = 1 ;
+        if ( ! total )
+        {
+            return score ;
+        }
+
+        for ( int s = -mMaxShift ; s <= mMaxShift ; s++ )
+        {
+            double diff = 0 ;
+            for ( int r = 0 ; r < mCode.getHeight() ; r++ )
+            {
+                diff += countRowDifferences(pRecord,s,r,firstFilter,nFilters) ;
+            }
+            float mean = diff / total ;
+            score = min(score,mean) ;
+        }
+
+        return score ;
+    }
+
+
+
+    bool OsiProbe::verify ( const uint64_t * pRecord , int firstFilter , int nFilters , float threshold , float & rScore ) const
+    {
+        double total = countValidBits(pRecord) * nFilters ;
+
+        // Best complete score, and lower bound of the score for the abandoned shifts
+        float score = 1 ;
+        float bound = 1 ;
+        if ( ! total )
+        {
+            rScore = score ;
+            return score < threshold ;
+        }
+
+        // Small shifts first, a shift is abandoned when it cannot beat the best score and the threshold
+        for ( int k = 0 ; k <= 2 * mMaxShift ; k++ )
+        {
+            int s = ( k % 2 ) ? ( k + 1 ) / 2 : - k / 2 ;
+            float limit = min(score,threshold) ;
+            double diff = 0 ;
+            float mean = 0 ;
+            bool abandoned = false ;
+            for ( int r = 0 ; r < mCode.getHeight() && ! abandoned ; r++ )
+            {
+                diff += countRowDifferences(pRecord,s,r,firstFilter,nFilters) ;
+                mean = diff / total ;
+                abandoned = ( mean >= limit ) ;
+            }
+
+            if ( abandoned )
+            {
+                bound = min(bound,mean) ;
+            }
+            else
+            {
+                score = mean ;
+            }
+        }
+
+        bool accepted = ( score < threshold ) ;
+        rScore = accepted ? score : min(score,bound) ;
+
+        return accepted ;
+    }
+
+
+
+
+
+    ///////////////////////////////////
+    // PRIVATE METHODS
+    ///////////////////////////////////
+
+
+    // Get one row of a shifted code plane
+    const uint64_t * OsiProbe::getShiftedRow ( int shift , int filter , int row ) const
+    {
+        int n_words = mCode.getNumberOfWords() ;
+        int n_rows = mCode.getHeight() ;
+        int n_filters = mCode.getNumberOfFilters() ;
+        return &mShifts[ ( ( (size_t)(shift+mMaxShift) * n_filters + filter ) * n_rows + row ) * n_words ] ;
+    }
+
+
+
+    // Check that a template can be matched against the probe
+    void OsiProbe::checkTemplate ( const OsiIrisCode & rCode ) const
+    {
+        if ( mCode.isEmpty() || rCode.isEmpty() )
+        {
+            throw runtime_error("Cannot match because one of the packed iris codes is empty") ;
+        }
+        if ( ! mCode.isCompatible(rCode) )
+        {
+            throw runtime_error("Cannot match iris codes of different sizes") ;
+        }
+    }
+
+
+
+    // Count the bits on in both masks, for one code plane
+    double OsiProbe::countValidBits ( const uint64_t * pRecord ) const
+    {
+        int n_words = mCode.getNumberOfWords() ;
+        const uint64_t * p_masks = pRecord + (size_t)mCode.getNumberOfFilters() * mCode.getHeight() * n_words ;
+
+        double total = 0 ;
+        for ( int r = 0 ; r < mCode.getHeight() ; r++ )
+        {
+            const uint64_t * p_mask1 = mCode.getMaskRow(r) ;
+            const uint64_t * p_mask2 = p_masks + r * n_words ;
+            for ( int w = 0 ; w < mCode.getNumberOfWords() ; w++ )
+            {
+                total += OsiIrisCode::countBits(p_mask1[w]&p_mask2[w]) ;
+            }
+        }
+
+        return total ;
+    }
+
+
+
+    // Count the disagreeing valid bits of one row for one shift, on a band of code planes
+    int OsiProbe::countRowDifferences ( const uint64_t * pRecord , int shift , int row , int firstFilter , int nFilters ) const
+    {
+        int n_words = mCode.getNumberOfWords() ;
+        int n_rows = mCode.getHeight() ;
+        const uint64_t * p_mask1 = mCode.getMaskRow(row) ;
+        const uint64_t * p_mask2 = pRecord + ( (size_t)mCode.getNumberOfFilters() * n_rows + row ) * n_words ;
+
+        // The code planes of the shifted probe and of the record have the same layout
+        return OsiHamming::countDifferences(getShiftedRow(shift,firstFilter,row),(size_t)n_rows*n_words,
+                                            pRecord+((size_t)firstFilter*n_rows+row)*n_words,(size_t)n_rows*n_words,
+                                            p_mask1,p_mask2,n_words,nFilters) ;
+    }
+
+} // end of namespace
+
@@ -0,0 +1,160 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_PROBE_H
+#define OSI_PROBE_H
+
+#include <vector>
+#include <stdint.h>
+#include "OsiIrisCode.h"
+
+namespace osiris
+{
+
+    /** Probe prepared for repeated comparisons.
+    * All the shifted versions of the probe code are built once, so that comparing
+    * the probe to a template only costs the XOR/AND/popcount work, without any
+    * allocation nor bit shifting. The mask is not shifted during matching, so it
+    * is used as it is.\n
+    * Scores are the same as OsiIrisCode::match() and OsiIrisCode::verify() with
+    * the probe as first code.
+    * @see OsiIrisCode , OsiGallery , OsiScoreMatrix
+    */
+    class OsiProbe
+    {
+
+    public :
+
+        /** Default constructor. Build an empty probe. */
+        OsiProbe ( ) ;
+
+        /** Constructor. Build all the shifted versions of the code.
+        * @param rCode The probe code
+        * @param maxShift The maximum shift in columns
+        */
+        OsiProbe ( const OsiIrisCode & rCode , int maxShift = OSI_MAX_SHIFT ) ;
+
+        /** Default destructor. */
+        ~OsiProbe ( ) ;
+
+        /** Build all the shifted versions of the code.
+        * @param rCode The probe code
+        * @param maxShift The maximum shift in columns
+        * @return void
+        */
+        void create ( const OsiIrisCode & rCode , int maxShift = OSI_MAX_SHIFT ) ;
+
+        /** Get the probe code.
+        * @return The code
+        */
+        const OsiIrisCode & getCode ( ) const ;
+
+        /** Match the probe against a template.
+        * @param rCode The template. Must have the same size as the probe.
+        * @return The matching score between 0 (completely similar) and 1 (completely different)
+        * @see OsiIrisCode::match()
+        */
+        float match ( const OsiIrisCode & rCode ) const ;
+
+        /** Match the probe against a template and a decision threshold, stop early if possible.
+        * @param rCode The template. Must have the same size as the probe.
+        * @param threshold The decision threshold
+        * @param rScore The score. Exact if accepted, else a lower bound of the score (not below the threshold)
+        * @return true if the score is below the threshold (accepted)
+        * @see OsiIrisCode::verify()
+        */
+        bool verify ( const OsiIrisCode & rCode , float threshold , float & rScore ) const ;
+
+        /** Match the probe against the words of a template (no size check).
+        * @param pRecord The words of a template of the same size as the probe, laid out as OsiIrisCode::getData()
+        * @return The matching score between 0 (completely similar) and 1 (completely different)
+        * @see match()
+        */
+        float match ( const uint64_t * pRecord ) const ;
+
+        /** Match the probe against the words of a template and a decision threshold (no size check).
+        * @param pRecord The words of a template of the same size as the probe, laid out as OsiIrisCode::getData()
+        * @param threshold The decision threshold
+        * @param rScore The score. Exact if accepted, else a lower bound of the score (not below the threshold)
+        * @return true if the score is below the threshold (accepted)
+        * @see verify()
+        */
+        bool verify ( const uint64_t * pRecord , float threshold , float & rScore ) const ;
+
+        /** Match the probe against the words of a template on a band of code planes only (no size check).
+        * The score is computed over all shifts like match(), with the bits of the planes
+        * firstFilter to firstFilter+nFilters-1 : it costs a fraction of a complete matching,
+        * and is a good estimation of the complete score when the band holds the real and
+        * imaginary planes of one filter.
+        * @param pRecord The words of a template of the same size as the probe, laid out as OsiIrisCode::getData()
+        * @param firstFilter The first code plane of the band
+        * @param nFilters The number of code planes of the band
+        * @return The matching score on the band, between 0 (completely similar) and 1 (completely different)
+        * @see match()
+        */
+        float match ( const uint64_t * pRecord , int firstFilter , int nFilters ) const ;
+
+        /** Match the probe against the words of a template and a decision threshold, on a band of code planes only (no size check).
+        * @param pRecord The words of a template of the same size as the probe, laid out as OsiIrisCode::getData()
+        * @param firstFilter The first code plane of the band
+        * @param nFilters The number of code planes of the band
+        * @param threshold The decision threshold
+        * @param rScore The score on the band. Exact if accepted, else a lower bound of the score (not below the threshold)
+        * @return true if the score is below the threshold (accepted)
+        * @see verify()
+        */
+        bool verify ( const uint64_t * pRecord , int firstFilter , int nFilters , float threshold , float & rScore ) const ;
+
+    private :
+
+        /** The probe code. */
+        OsiIrisCode mCode ;
+
+        /** The maximum shift in columns. */
+        int mMaxShift ;
+
+        /** The shifted code planes : shift from -mMaxShift to +mMaxShift, then filter, row, word. */
+        std::vector<uint64_t> mShifts ;
+
+        /** Get one row of a shifted code plane.
+        * @param shift The shift in columns
+        * @param filter The index of the code plane
+        * @param row The row in the plane
+        * @return A pointer on the first word of the row
+        */
+        const uint64_t * getShiftedRow ( int shift , int filter , int row ) const ;
+
+        /** Check that a template can be matched against the probe.
+        * @param rCode The template
+        * @return void
+        */
+        void checkTemplate ( const OsiIrisCode & rCode ) const ;
+
+        /** Count the bits to compare (on in both masks).
+        * @param pRecord The words of the template
+        * @return The number of bits to compare, for one code plane
+        */
+        double countValidBits ( const uint64_t * pRecord ) const ;
+
+        /** Count the disagreeing bits of one row for one shift, on a band of code planes.
+        * @param pRecord The words of the template
+        * @param shift The shift in columns
+        * @param row The row
+        * @param firstFilter The first code plane of the band
+        * @param nFilters The number of code planes of the band
+        * @return The number of disagreeing valid bits
+        */
+        int countRowDifferences ( const uint64_t * pRecord , int shift , int row , int firstFilter , int nFilters ) const ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
@@ -6,6 +6,9 @@
 * License : BSD
 ********************************************************/
 
+#include <atomic>
+#include <cstring>
+#include <thread>
 #include "cv.hpp"
 #include "opencv2/opencv.hpp"
 #include "OsiStringUtils.h"
@@ -385,8 +388,8 @@ namespace osiris
 												      IplImage * pDst ,
 											    const OsiCircle & rPupil ,
 												const OsiCircle & rIris ,
-												const vector<float> rThetaCoarsePupil ,
-												const vector<float> rThetaCoarseIris ,
+												const vector<float> & rThetaCoarsePupil ,
+												const vector<float> & rThetaCoarseIris ,
 												const vector<CvPoint> & rPupilCoarseContour ,
 												const vector<CvPoint> & rIrisCoarseContour )
     {
@@ -429,8 +432,8 @@ namespace osiris
     }
 
 
-    CvPoint OsiProcessings::interpolate ( const vector<CvPoint> coarseContour ,
-									      const vector<float> coarseTheta ,
+    CvPoint OsiProcessings::interpolate ( const vector<CvPoint> & coarseContour ,
+									      const vector<float> & coarseTheta ,
 									      const float theta )
     {
 		float interpolation ;
@@ -467,6 +470,172 @@ namespace osiris
 	}
 
 
+
+    // Points of a coarse contour at the angles of all columns, as interpolate() computes them.
+    // The angles increase with the columns, so the coarse angles are walked only once
+    static void interpolateContour ( const vector<CvPoint> & rCoarseContour ,
+                                     const vector<float> & rCoarseTheta ,
+                                     int width ,
+                                     vector<CvPoint2D32f> & rPoints )
+    {
+        rPoints.resize(width) ;
+        int last = rCoarseTheta.size() - 1 ;
+        int i = 0 ;
+        for ( int j = 0 ; j < width ; j++ )
+        {
+            float theta = (float) j / width * 2 * OSI_PI ;
+            float interpolation ;
+            int i1 , i2 ;
+            if ( theta < rCoarseTheta[0] )
+            {
+                i1 = last ;
+                i2 = 0 ;
+                interpolation = ( theta - (rCoarseTheta[i1]-2*OSI_PI) ) / ( rCoarseTheta[i2] - (rCoarseTheta[i1]-2*OSI_PI) ) ;
+            }
+            else if ( theta >= rCoarseTheta[last] )
+            {
+                i1 = last ;
+                i2 = 0 ;
+                interpolation = ( theta - rCoarseTheta[i1] ) / ( rCoarseTheta[i2]+2*OSI_PI - rCoarseTheta[i1] ) ;
+            }
+            else
+            {
+                while ( rCoarseTheta[i+1] <= theta ) i++ ;
+                i1 = i ;
+                i2 = i + 1 ;
+                interpolation = ( theta - rCoarseTheta[i1] ) / ( rCoarseTheta[i2] - rCoarseTheta[i1] ) ;
+            }
+            rPoints[j].x = (1-interpolation) * rCoarseContour[i1].x + interpolation * rCoarseContour[i2].x ;
+            rPoints[j].y = (1-interpolation) * rCoarseContour[i1].y + interpolation * rCoarseContour[i2].y ;
+        }
+    }
+
+
+
+    void OsiProcessings::computeNormalizationMap ( CvMat * pMapX ,
+                                                   CvMat * pMapY ,
+                                                   const vector<float> & rThetaCoarsePupil ,
+                                                   const vector<float> & rThetaCoarseIris ,
+                                                   const vector<CvPoint> & rPupilCoarseContour ,
+                                                   const vector<CvPoint> & rIrisCoarseContour ,
+                                                   bool bilinear )
+    {
+        int width = pMapX->cols ;
+        int height = pMapX->rows ;
+
+        // Points of both contours for each column
+        vector<CvPoint2D32f> pupil , iris ;
+        interpolateContour(rPupilCoarseContour,rThetaCoarsePupil,width,pupil) ;
+        interpolateContour(rIrisCoarseContour,rThetaCoarseIris,width,iris) ;
+
+        // Without interpolation, the points and the samples are rounded down to pixels
+        if ( ! bilinear )
+        {
+            for ( int j = 0 ; j < width ; j++ )
+            {
+                pupil[j] = cvPoint2D32f((int)pupil[j].x,(int)pupil[j].y) ;
+                iris[j] = cvPoint2D32f((int)iris[j].x,(int)iris[j].y) ;
+            }
+        }
+
+        // Row by row : the radial parameter is the same along a row
+        for ( int i = 0 ; i < height ; i++ )
+        {
+            float radius = (float) i / height ;
+            float * p_x = (float*)(pMapX->data.ptr+i*pMapX->step) ;
+            float * p_y = (float*)(pMapY->data.ptr+i*pMapY->step) ;
+            for ( int j = 0 ; j < width ; j++ )
+            {
+                float x = (1-radius) * pupil[j].x + radius * iris[j].x ;
+                float y = (1-radius) * pupil[j].y + radius * iris[j].y ;
+                p_x[j] = bilinear ? x : (int) x ;
+                p_y[j] = bilinear ? y : (int) y ;
+            }
+        }
+    }
+
+
+
+    void OsiProcessings::normalizeFromMap ( const IplImage * pSrc ,
+                                            const IplImage * pSrcMask ,
+                                                  IplImage * pDst ,
+                                                  IplImage * pDstMask ,
+                                            const CvMat * pMapX ,
+                                            const CvMat * pMapY ,
+                                            bool bilinear ,
+                                            uint64_t * pValidity )
+    {
+        if ( pSrcMask->width != pSrc->width || pSrcMask->height != pSrc->height ||
+             pDstMask->width != pDst->width || pDstMask->height != pDst->height )
+        {
+            throw runtime_error("Cannot normalize because the masks do not have the size of the images") ;
+        }
+
+        int width = pDst->width ;
+        int height = pDst->height ;
+        int words = ( width + 63 ) / 64 ;
+
+        for ( int i = 0 ; i < height ; i++ )
+        {
+            const float * p_x = (const float*)(pMapX->data.ptr+i*pMapX->step) ;
+            const float * p_y = (const float*)(pMapY->data.ptr+i*pMapY->step) ;
+            uchar * p_dst = (uchar*)(pDst->imageData+i*pDst->widthStep) ;
+            uchar * p_dst_mask = (uchar*)(pDstMask->imageData+i*pDstMask->widthStep) ;
+            uint64_t * p_validity = pValidity ? pValidity + i * words : 0 ;
+            if ( p_validity )
+            {
+                memset(p_validity,0,words*sizeof(uint64_t)) ;
+            }
+
+            for ( int j = 0 ; j < width ; j++ )
+            {
+                // Mask, and image without interpolation : nearest pixel
+                int x = cvRound(p_x[j]) ;
+                int y = cvRound(p_y[j]) ;
+                bool inside = ( x >= 0 && x < pSrc->width && y >= 0 && y < pSrc->height ) ;
+                uchar mask = inside ? ((const uchar*)(pSrcMask->imageData+y*pSrcMask->widthStep))[x] : 0 ;
+                p_dst_mask[j] = mask ;
+                if ( p_validity && mask )
+                {
+                    p_validity[j/64] |= (uint64_t) 1 << (j%64) ;
+                }
+
+                if ( ! bilinear )
+                {
+                    p_dst[j] = inside ? ((const uchar*)(pSrc->imageData+y*pSrc->widthStep))[x] : 0 ;
+                    continue ;
+                }
+
+                // Bilinear interpolation, the neighbours outside of the image count as 0
+                int x0 = cvFloor(p_x[j]) ;
+                int y0 = cvFloor(p_y[j]) ;
+                float fx = p_x[j] - x0 ;
+                float fy = p_y[j] - y0 ;
+                float value = 0 ;
+                for ( int dy = 0 ; dy < 2 ; dy++ )
+                {
+                    int yy = y0 + dy ;
+                    if ( yy < 0 || yy >= pSrc->height )
+                    {
+                        continue ;
+                    }
+                    const uchar * p_src = (const uchar*)(pSrc->imageData+yy*pSrc->widthStep) ;
+                    float wy = dy ? fy : 1 - fy ;
+                    if ( x0 >= 0 && x0 < pSrc->width )
+                    {
+                        value += wy * ( 1 - fx ) * p_src[x0] ;
+                    }
+                    if ( x0 + 1 >= 0 && x0 + 1 < pSrc->width )
+                    {
+                        value += wy * fx * p_src[x0+1] ;
+                    }
+                }
+                p_dst[j] = (uchar) min(cvRound(value),255) ;
+            }
+        }
+    }
+
+
     void OsiProcessings::encode ( const IplImage * pSrc ,
                                         IplImage * pDst ,
                                   const vector<CvMat*> & rFilters )
@@ -510,6 +679,343 @@ namespace osiris
 
 
 
+    void OsiProcessings::encode ( const vector<const IplImage*> & rSrc ,
+                                  const vector<IplImage*> & rDst ,
+                                  const vector<CvMat*> & rFilters ,
+                                        int nThreads )
+    {
+        // Check arguments
+        if ( rSrc.size() != rDst.size() )
+        {
+            throw invalid_argument("Error in function encode : there must be one iris code per normalized iris") ;
+        }
+        int n_images = rSrc.size() ;
+        for ( int i = 0 ; i < n_images ; i++ )
+        {
+            if ( rDst[i]->width != rSrc[i]->width || rDst[i]->height != rSrc[i]->height * (int)rFilters.size() )
+            {
+                throw invalid_argument("Error in function encode : an iris code must have one normalized iris per filter") ;
+            }
+        }
+        int n_items = n_images * rFilters.size() ;
+        if ( ! n_items )
+        {
+            return ;
+        }
+        if ( nThreads <= 0 )
+        {
+            nThreads = max((int)thread::hardware_concurrency(),1) ;
+        }
+        nThreads = min(nThreads,n_items) ;
+
+        // Compute the maximum width of the filters
+        int max_width = 0 ;
+        for ( int f = 0 ; f < rFilters.size() ; f++ )
+            if (rFilters[f]->cols > max_width)
+                max_width = rFilters[f]->cols ;
+        max_width = (max_width-1)/2 ;
+
+        // Add wrapping borders on the left and right of images for convolution, once for all filters
+        vector<IplImage*> resized(n_images) ;
+        for ( int i = 0 ; i < n_images ; i++ )
+        {
+            resized[i] = addBorders(rSrc[i],max_width) ;
+        }
+
+        // Each thread takes the next convolution, filter by filter, into its own temporary image
+        atomic<int> next_item(0) ;
+        auto encode_items = [&]( )
+        {
+            IplImage * img1 = 0 ;
+            for ( int item = next_item++ ; item < n_items ; item = next_item++ )
+            {
+                int f = item / n_images ;
+                int i = item % n_images ;
+                const IplImage * p_src = rSrc[i] ;
+                if ( ! img1 || img1->width != resized[i]->width || img1->height != resized[i]->height )
+                {
+                    cvReleaseImage(&img1) ;
+                    img1 = cvCreateImage(cvGetSize(resized[i]),IPL_DEPTH_32F,1) ;
+                }
+
+                // Convolution
+                cvFilter2D(resized[i],img1,rFilters[f]) ;
+
+                // Threshold : above or below 0, directly into the rows of the filter in the iris code
+                // (headers on the rows, the images are shared by the threads)
+                CvMat responses , code ;
+                cvGetSubRect(img1,&responses,cvRect(max_width,0,p_src->width,p_src->height)) ;
+                cvGetSubRect(rDst[i],&code,cvRect(0,f*p_src->height,p_src->width,p_src->height)) ;
+                cvThreshold(&responses,&code,0,255,CV_THRESH_BINARY) ;
+            }
+            cvReleaseImage(&img1) ;
+        } ;
+        vector<thread> workers ;
+        for ( int t = 1 ; t < nThreads ; t++ )
+        {
+            workers.push_back(thread(encode_items)) ;
+        }
+        encode_items() ;
+        for ( int t = 0 ; t < workers.size() ; t++ )
+        {
+            workers[t].join() ;
+        }
+
+        // Free memory
+        for ( int i = 0 ; i < n_images ; i++ )
+        {
+            cvReleaseImage(&resized[i]) ;
+        }
+    }
+
+
+
+    void OsiProcessings::encode ( const IplImage * pSrc ,
+                                        IplImage * pDst ,
+                                  const OsiFilterSpectra & rSpectra )
+    {
+        // Check arguments
+        OsiStringUtils str ;
+        if ( pSrc->width != rSpectra.getWidth() || pSrc->height != rSpectra.getHeight() )
+        {
+            throw invalid_argument("Error in function encode : the spectra of filters are computed for a normalized image of " +
+                                   str.toString(rSpectra.getWidth()) + "x" +
+                                   str.toString(rSpectra.getHeight())) ;
+        }
+
+        // Rows above and below replicate the first and last rows, no border is needed on the
+        // left and right because the DFT wraps around. The rows after are not used by the code
+        int border = rSpectra.getBorder() ;
+        int height = pSrc->height + 2 * border ;
+        IplImage * padded = cvCreateImage(cvSize(pSrc->width,height),pSrc->depth,1) ;
+        cvCopyMakeBorder(pSrc,padded,cvPoint(0,border),IPL_BORDER_REPLICATE,cvScalarAll(0)) ;
+
+        // Spectrum of the image
+        CvMat * spectrum = cvCreateMat(rSpectra.getPaddedHeight(),pSrc->width,CV_32FC1) ;
+        CvMat rows ;
+        cvZero(spectrum) ;
+        cvConvert(padded,cvGetSubRect(spectrum,&rows,cvRect(0,0,pSrc->width,height))) ;
+        cvDFT(spectrum,spectrum,CV_DXT_FORWARD,height) ;
+
+        // Temporary matrix to store the result of correlation (not scaled, only the sign is kept)
+        CvMat * response = cvCreateMat(rSpectra.getPaddedHeight(),pSrc->width,CV_32FC1) ;
+
+        // Loop on filters
+        for ( int f = 0 ; f < rSpectra.getNumberOfFilters() ; f++ )
+        {
+            // Correlation : product by the conjugate spectrum of the filter
+            cvMulSpectrums(spectrum,rSpectra.getSpectrum(f),response,CV_DXT_MUL_CONJ) ;
+            cvDFT(response,response,CV_DXT_INVERSE,border+pSrc->height) ;
+
+            // Threshold : above or below 0, and form the iris code
+            cvGetSubRect(response,&rows,cvRect(0,border,pSrc->width,pSrc->height)) ;
+            cvSetImageROI(pDst,cvRect(0,f*pSrc->height,pSrc->width,pSrc->height)) ;
+            cvThreshold(&rows,pDst,0,255,CV_THRESH_BINARY) ;
+            cvResetImageROI(pDst) ;
+        }
+
+        // Free memory
+        cvReleaseMat(&response) ;
+        cvReleaseMat(&spectrum) ;
+        cvReleaseImage(&padded) ;
+    }
+
+
+
+    void OsiProcessings::encode ( const IplImage * pSrc ,
+                                        IplImage * pDst ,
+                                  const OsiSeparableFilters & rFilters )
+    {
+        // Compute the maximum width of the filters
+        int max_width = 0 ;
+        for ( int f = 0 ; f < rFilters.getNumberOfFilters() ; f++ )
+            for ( int k = 0 ; k < rFilters.getNumberOfTerms(f) ; k++ )
+                if (rFilters.getRowKernel(f,k)->cols > max_width)
+                    max_width = rFilters.getRowKernel(f,k)->cols ;
+        max_width = (max_width-1)/2 ;
+
+        // Add wrapping borders on the left and right of image for convolution
+        IplImage * resized = addBorders(pSrc,max_width) ;
+
+        // Temporary images to store the result of both passes and their sum over the terms
+        IplImage * columns = cvCreateImage(cvGetSize(resized),IPL_DEPTH_32F,1) ;
+        IplImage * term = cvCreateImage(cvGetSize(resized),IPL_DEPTH_32F,1) ;
+        IplImage * img1 = cvCreateImage(cvGetSize(resized),IPL_DEPTH_32F,1) ;
+        IplImage * img2 = cvCreateImage(cvGetSize(resized),pDst->depth,1) ;
+
+        // Loop on filters
+        for ( int f = 0 ; f < rFilters.getNumberOfFilters() ; f++ )
+        {
+            // Sum of the separable terms : same anchors and borders as the dense convolution
+            cvZero(img1) ;
+            for ( int k = 0 ; k < rFilters.getNumberOfTerms(f) ; k++ )
+            {
+                cvFilter2D(resized,columns,rFilters.getColumnKernel(f,k)) ;
+                cvFilter2D(columns,term,rFilters.getRowKernel(f,k)) ;
+                cvAdd(img1,term,img1) ;
+            }
+
+            // Threshold : above or below 0, up to the rounding of both passes
+            cvThreshold(img1,img2,rFilters.getTolerance(f),255,CV_THRESH_BINARY) ;
+
+            // Form the iris code
+            cvSetImageROI(img2,cvRect(max_width,0,pSrc->width,pSrc->height)) ;
+            cvSetImageROI(pDst,cvRect(0,f*pSrc->height,pSrc->width,pSrc->height)) ;
+            cvCopy(img2,pDst,NULL) ;
+            cvResetImageROI(img2) ;
+            cvResetImageROI(pDst) ;
+        }
+
+        // Free memory
+        cvReleaseImage(&columns) ;
+        cvReleaseImage(&term) ;
+        cvReleaseImage(&img1) ;
+        cvReleaseImage(&img2) ;
+        cvReleaseImage(&resized) ;
+    }
+
+
+
+    void OsiProcessings::encode ( const IplImage * pSrc ,
+                                        OsiIrisCode & rCode ,
+                                  const vector<CvMat*> & rFilters ,
+                                  const CvMat * pApplicationPoints ,
+                                        int maxShift )
+    {
+        // Check arguments
+        if ( pSrc->depth != IPL_DEPTH_8U || pSrc->nChannels != 1 )
+        {
+            throw invalid_argument("Error in function encode : the normalized image must be 8-bit grayscale") ;
+        }
+        if ( pApplicationPoints->cols != pSrc->width || pApplicationPoints->rows != pSrc->height ||
+             rCode.getWidth() != pSrc->width || rCode.getNumberOfFilters() != rFilters.size() )
+        {
+            throw invalid_argument("Error in function encode : the sizes of normalized image, application points and code do not match") ;
+        }
+        int width = pSrc->width ;
+        int height = pSrc->height ;
+
+        // Column of the normalized image wrapping around, for the columns -max_width to width+max_width
+        int max_width = 0 ;
+        for ( int f = 0 ; f < rFilters.size() ; f++ )
+            if (rFilters[f]->cols > max_width)
+                max_width = rFilters[f]->cols ;
+        max_width = max(max_width,2*maxShift+1) ;
+        vector<int> wrap(width+2*max_width) ;
+        for ( int x = 0 ; x < wrap.size() ; x++ )
+        {
+            wrap[x] = ( ( x - max_width ) % width + width ) % width ;
+        }
+
+        // Loop on the rows of the code
+        vector<char> needed(width) ;
+        vector<int> columns ;
+        for ( int k = 0 ; k < rCode.getHeight() ; k++ )
+        {
+            // Columns read by the matching : application points and their shifts
+            int i = rCode.getRowIndex(k) ;
+            const uchar * p_points = pApplicationPoints->data.ptr + i*pApplicationPoints->step ;
+            fill(needed.begin(),needed.end(),0) ;
+            for ( int j = 0 ; j < width ; j++ )
+            {
+                if ( p_points[j] )
+                {
+                    for ( int s = -maxShift ; s <= maxShift ; s++ )
+                    {
+                        needed[wrap[j+s+max_width]] = 1 ;
+                    }
+                }
+            }
+            columns.clear() ;
+            for ( int j = 0 ; j < width ; j++ )
+            {
+                if ( needed[j] )
+                {
+                    columns.push_back(j) ;
+                }
+            }
+
+            // Correlation at these columns, with the anchor at the center of the kernel and
+            // the first and last rows replicated, as cvFilter2D does
+            for ( int f = 0 ; f < rFilters.size() ; f++ )
+            {
+                const CvMat * p_filter = rFilters[f] ;
+                int ay = p_filter->rows / 2 ;
+                int ax = p_filter->cols / 2 ;
+                for ( int c = 0 ; c < columns.size() ; c++ )
+                {
+                    double sum = 0 ;
+                    for ( int a = 0 ; a < p_filter->rows ; a++ )
+                    {
+                        int y = min(max(i+a-ay,0),height-1) ;
+                        const uchar * p_src = (uchar*)(pSrc->imageData+y*pSrc->widthStep) ;
+                        const float * p_kernel = (const float*)(p_filter->data.ptr+a*p_filter->step) ;
+                        const int * p_wrap = &wrap[columns[c]-ax+max_width] ;
+                        for ( int b = 0 ; b < p_filter->cols ; b++ )
+                        {
+                            sum += p_kernel[b] * p_src[p_wrap[b]] ;
+                        }
+                    }
+
+                    // Threshold : above or below 0
+                    rCode.setCodeBit(f,k,columns[c],sum>0) ;
+                }
+            }
+        }
+    }
+
+
+
+    void OsiProcessings::encode ( const IplImage * pSrc ,
+                                        OsiIrisCode & rCode ,
+                                  const OsiFixedPointFilters & rFilters )
+    {
+        // Check arguments
+        if ( pSrc->depth != IPL_DEPTH_8U || pSrc->nChannels != 1 )
+        {
+            throw invalid_argument("Error in function encode : the normalized image must be 8-bit grayscale") ;
+        }
+        if ( rCode.getWidth() != pSrc->width || rCode.getNumberOfFilters() != rFilters.getNumberOfFilters() )
+        {
+            throw invalid_argument("Error in function encode : the sizes of normalized image and code do not match") ;
+        }
+        int width = pSrc->width ;
+        int height = pSrc->height ;
+
+        // Pixels on 16 bits, with wrapping borders on the left and right of each row
+        int border = rFilters.getBorder() ;
+        int step = width + 2 * border ;
+        vector<int16_t> pixels(height*step) ;
+        for ( int i = 0 ; i < height ; i++ )
+        {
+            const uchar * p_src = (uchar*)(pSrc->imageData+i*pSrc->widthStep) ;
+            int16_t * p_row = &pixels[i*step] ;
+            for ( int x = 0 ; x < step ; x++ )
+            {
+                p_row[x] = p_src[((x-border)%width+width)%width] ;
+            }
+        }
+
+        // Loop on filters and rows of the code : the first and last rows are replicated, as cvFilter2D does
+        vector<const int16_t*> rows ;
+        for ( int f = 0 ; f < rFilters.getNumberOfFilters() ; f++ )
+        {
+            int n_rows = rFilters.getRows(f) ;
+            rows.resize(n_rows) ;
+            for ( int k = 0 ; k < rCode.getHeight() ; k++ )
+            {
+                int i = rCode.getRowIndex(k) ;
+                for ( int a = 0 ; a < n_rows ; a++ )
+                {
+                    rows[a] = &pixels[min(max(i+a-n_rows/2,0),height-1)*step+border] ;
+                }
+                rFilters.encodeRow(&rows[0],width,f,rCode.getCodeRow(f,k)) ;
+            }
+        }
+    }
+
+
+
     float OsiProcessings::match ( const IplImage * image1 ,
                                   const IplImage * image2 ,
                                   const IplImage * mask )
@@ -21,6 +21,10 @@
 
 #include "highgui.h"
 #include "OsiCircle.h"
+#include "OsiFilterSpectra.h"
+#include "OsiFixedPointFilters.h"
+#include "OsiIrisCode.h"
+#include "OsiSeparableFilters.h"
 
 namespace osiris
 {
@@ -104,17 +108,72 @@ namespace osiris
 										  IplImage * pDst ,
 									const OsiCircle & rPupil ,
 									const OsiCircle & rIris ,
-									const std::vector<float> rThetaCoarsePupil ,
-									const std::vector<float> rThetaCoarseIris ,
+									const std::vector<float> & rThetaCoarsePupil ,
+									const std::vector<float> & rThetaCoarseIris ,
 									const std::vector<CvPoint> & rPupilCoarseContour ,
 									const std::vector<CvPoint> & rIrisCoarseContour ) ;
 
 
-		CvPoint interpolate ( const std::vector<CvPoint> coarseContour ,
-											const std::vector<float> coarseTheta ,
+		CvPoint interpolate ( const std::vector<CvPoint> & coarseContour ,
+											const std::vector<float> & coarseTheta ,
 										    const float theta ) ;
 
 
+
+        /** Compute the sampling grid of Daugman's rubber sheet between two contours.
+        * The maps give, for each pixel of the normalized image, the coordinates of the pixel of the
+        * source image, as cvRemap() takes them. They are computed once per eye and used for the
+        * image and for the mask. The contour points of each column are interpolated by walking the
+        * coarse angles once, instead of searching them for each column.
+        * @param pMapX The abscissas. Must be created BEFORE this function (CV_32FC1, size of the normalized image)
+        * @param pMapY The ordinates. Must be created BEFORE this function (CV_32FC1, size of the normalized image)
+        * @param rThetaCoarsePupil The angles of the coarse pupil contour, in increasing order
+        * @param rThetaCoarseIris The angles of the coarse iris contour, in increasing order
+        * @param rPupilCoarseContour The coarse pupil contour
+        * @param rIrisCoarseContour The coarse iris contour
+        * @param bilinear false to round the coordinates down to pixels, as normalizeFromContour() does,
+        * true to keep them as they are, for bilinear interpolation
+        * @return void
+        * @see normalizeFromMap() , OsiEye::normalize()
+        */
+        void computeNormalizationMap ( CvMat * pMapX ,
+                                       CvMat * pMapY ,
+                                       const std::vector<float> & rThetaCoarsePupil ,
+                                       const std::vector<float> & rThetaCoarseIris ,
+                                       const std::vector<CvPoint> & rPupilCoarseContour ,
+                                       const std::vector<CvPoint> & rIrisCoarseContour ,
+                                       bool bilinear = false ) ;
+
+
+
+        /** Normalize iris and mask together, with a sampling grid computed by computeNormalizationMap().
+        * Both normalized images are written in a single pass, row by row : the coordinates of each
+        * sample are read once for both. The mask always takes the pixel nearest to the sample. The
+        * image takes the same pixel, or with bilinear interpolation the sum of the 4 pixels around
+        * the sample weighted by their distances, the neighbours outside of the source image counting
+        * as 0. The pixels sampled outside of the source images are set to 0.
+        * @param pSrc The source image
+        * @param pSrcMask The mask of the source image
+        * @param pDst The normalized image. Must be created BEFORE this function.
+        * @param pDstMask The normalized mask. Must be created BEFORE this function.
+        * @param pMapX The abscissas of the grid
+        * @param pMapY The ordinates of the grid
+        * @param bilinear true for bilinear interpolation of the image, false for the nearest pixel
+        * @param pValidity If not 0, the normalized mask packed as the masks of OsiIrisCode :
+        * (width+63)/64 words for each row, bit j%64 of word j/64 set where the mask is not 0
+        * @return void
+        * @see computeNormalizationMap() , OsiEye::normalize()
+        */
+        void normalizeFromMap ( const IplImage * pSrc ,
+                                const IplImage * pSrcMask ,
+                                      IplImage * pDst ,
+                                      IplImage * pDstMask ,
+                                const CvMat * pMapX ,
+                                const CvMat * pMapY ,
+                                bool bilinear = false ,
+                                uint64_t * pValidity = 0 ) ;
+
+
         /** Encode the iris texture into a binary image.
         * @param pSrc The normalized iris obtained by function normalize()
         * @param pDst The binary iris code. Must be created BEFORE this function.
@@ -126,6 +185,81 @@ namespace osiris
 
 
 
+        /** Encode several iris textures into binary images, in one workload.
+        * The work is made of one convolution per image and filter. The threads take them filter
+        * by filter, so that the coefficients of a filter stay in cache, and each thread keeps
+        * its own buffer for the responses. The borders of each image are built once for all filters.
+        * The iris codes are the same as the ones of encode() for each image.
+        * @param rSrc The normalized irises obtained by function normalize()
+        * @param rDst The binary iris codes, one per normalized iris. Must be created BEFORE this function.
+        * @param rFilters The bank of Gabor filters used to encode the iris texture.
+        * @param nThreads The number of threads, 0 for one per processor core
+        * @return void
+        * @see OsiEye::encode()
+        */
+        void encode ( const std::vector<const IplImage*> & rSrc , const std::vector<IplImage*> & rDst ,
+                      const std::vector<CvMat*> & rFilters , int nThreads ) ;
+
+
+
+        /** Encode the iris texture into a binary image, in the frequency domain.
+        * Same iris code as the convolution with the filters, up to the responses close to 0
+        * (rounding differs). The cost does not depend on the size of the kernels.
+        * @param pSrc The normalized iris obtained by function normalize()
+        * @param pDst The binary iris code. Must be created BEFORE this function.
+        * @param rSpectra The spectra of the bank of Gabor filters, for the size of pSrc
+        * @return void
+        * @see OsiFilterSpectra , OsiEye::encode()
+        */
+        void encode ( const IplImage * pSrc , IplImage * pDst , const OsiFilterSpectra & rSpectra ) ;
+
+
+
+        /** Encode the iris texture into a binary image, with separable approximations of the filters.
+        * Each filter is replaced by a sum of a column pass and a row pass per term, so the
+        * iris code may differ from the dense one where the approximation error changes the sign.
+        * @param pSrc The normalized iris obtained by function normalize()
+        * @param pDst The binary iris code. Must be created BEFORE this function.
+        * @param rFilters The separable approximations of the bank of Gabor filters
+        * @return void
+        * @see OsiSeparableFilters , OsiEye::encode()
+        */
+        void encode ( const IplImage * pSrc , IplImage * pDst , const OsiSeparableFilters & rFilters ) ;
+
+
+
+        /** Encode the iris texture only where the matching reads the code.
+        * The matching compares the code bits at the application points, the code being shifted
+        * by up to maxShift columns : only these bits are computed, on the rows kept by the code.
+        * They are the same as the ones of the dense encoding (up to the responses within rounding
+        * of 0), the other bits are left unchanged.
+        * @param pSrc The normalized iris obtained by function normalize()
+        * @param rCode The packed iris code, created with the size of pSrc and one plane per filter
+        * @param rFilters The bank of Gabor filters used to encode the iris texture.
+        * @param pApplicationPoints A binary image indicating which pixels
+        * will be considered for the matching. This image is the same size as pSrc.
+        * @param maxShift The maximum shift in columns tested during matching
+        * @return void
+        * @see OsiEye::encodeTemplate() , OsiIrisCode::match()
+        */
+        void encode ( const IplImage * pSrc , OsiIrisCode & rCode , const std::vector<CvMat*> & rFilters ,
+                      const CvMat * pApplicationPoints , int maxShift = OSI_MAX_SHIFT ) ;
+
+
+
+        /** Encode the iris texture into a packed code, with integer filters.
+        * The responses are computed in fixed point and their signs are written directly into
+        * the words of the code, for all the rows kept by the code.
+        * @param pSrc The normalized iris obtained by function normalize()
+        * @param rCode The packed iris code, created with the size of pSrc and one plane per filter
+        * @param rFilters The bank of Gabor filters, quantized
+        * @return void
+        * @see OsiFixedPointFilters , OsiEye::encode()
+        */
+        void encode ( const IplImage * pSrc , OsiIrisCode & rCode , const OsiFixedPointFilters & rFilters ) ;
+
+
+
         /** Match two iris codes.
         * @param image1 First binary iris code, obtained by function encode()
         * @param image2 Second binary iris code, obtained by function encode()
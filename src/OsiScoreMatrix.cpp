@@ -0,0 +1,267 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include "OsiProbe.h"
+#include "OsiScoreMatrix.h"
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiScoreMatrix::OsiScoreMatrix ( )
+    {
+        mRows = 0 ;
+        mCols = 0 ;
+        mSymmetric = false ;
+    }
+
+    OsiScoreMatrix::~OsiScoreMatrix ( )
+    {
+        // Do nothing
+    }
+
+
+
+
+
+    // Functions for computing the matrix
+    /////////////////////////////////////
+
+    void OsiScoreMatrix::compute ( const vector<OsiIrisCode> & rProbes ,
+                                   const vector<OsiIrisCode> & rGallery ,
+                                   int nThreads ,
+                                   int tileSize )
+    {
+        mRows = rProbes.size() ;
+        mCols = rGallery.size() ;
+        mSymmetric = false ;
+        mScores.assign((size_t)mRows*mCols,-1) ;
+
+        computeTiles(rProbes,rGallery,nThreads,tileSize) ;
+    }
+
+
+
+    void OsiScoreMatrix::compute ( const vector<OsiIrisCode> & rCodes ,
+                                   int nThreads ,
+                                   int tileSize )
+    {
+        mRows = rCodes.size() ;
+        mCols = rCodes.size() ;
+        mSymmetric = true ;
+        mScores.assign((size_t)mRows*mCols,-1) ;
+
+        computeTiles(rCodes,rCodes,nThreads,tileSize) ;
+
+        // Copy the upper triangle into the lower one
+        for ( int i = 0 ; i < mRows ; i++ )
+        {
+            for ( int j = 0 ; j < i ; j++ )
+            {
+                mScores[(size_t)i*mCols+j] = mScores[(size_t)j*mCols+i] ;
+            }
+        }
+    }
+
+
+
+    int OsiScoreMatrix::getNumberOfRows ( ) const
+    {
+        return mRows ;
+    }
+
+
+
+    int OsiScoreMatrix::getNumberOfCols ( ) const
+    {
+        return mCols ;
+    }
+
+
+
+    float OsiScoreMatrix::getScore ( int row , int col ) const
+    {
+        return mScores[(size_t)row*mCols+col] ;
+    }
+
+
+
+
+
+    // Functions for loading and saving
+    ///////////////////////////////////
+
+    void OsiScoreMatrix::save ( const string & rFilename ) const
+    {
+        // Open the file
+        ofstream file(rFilename.c_str(),ios::out|ios::binary) ;
+
+        // If file is not opened
+        if ( ! file )
+        {
+            throw runtime_error("Cannot save the matrix of scores in " + rFilename) ;
+        }
+
+        // Header : version, rows, columns, symmetric
+        int32_t header[4] = { 1 , mRows , mCols , mSymmetric } ;
+        file.write("OSIM",4) ;
+        file.write((const char*)header,sizeof(header)) ;
+
+        // Scores
+        if ( ! mScores.empty() )
+        {
+            file.write((const char*)&mScores[0],mScores.size()*sizeof(float)) ;
+        }
+
+        if ( ! file )
+        {
+            throw runtime_error("Error while saving matrix of scores in " + rFilename) ;
+        }
+
+        // Close the file
+        file.close() ;
+    }
+
+
+
+    void OsiScoreMatrix::load ( const string & rFilename )
+    {
+        // Open the file
+        ifstream file(rFilename.c_str(),ios::in|ios::binary) ;
+
+        // If file is not opened
+        if ( ! file )
+        {
+            throw runtime_error("Cannot load the matrix of scores in " + rFilename) ;
+        }
+
+        // Header
+        char magic[4] ;
+        int32_t header[4] ;
+        file.read(magic,4) ;
+        file.read((char*)header,sizeof(header)) ;
+        if ( ! file || string(magic,4) != "OSIM" || header[0] != 1 || header[1] < 0 || header[2] < 0 )
+        {
+            throw runtime_error("Invalid matrix of scores in " + rFilename) ;
+        }
+        mRows = header[1] ;
+        mCols = header[2] ;
+        mSymmetric = ( header[3] != 0 ) ;
+
+        // Scores
+        mScores.resize((size_t)mRows*mCols) ;
+        if ( ! mScores.empty() )
+        {
+            file.read((char*)&mScores[0],mScores.size()*sizeof(float)) ;
+        }
+        if ( ! file )
+        {
+            throw runtime_error("Error while loading matrix of scores from " + rFilename) ;
+        }
+
+        // Close the file
+        file.close() ;
+    }
+
+
+
+
+
+    ///////////////////////////////////
+    // PRIVATE METHODS
+    ///////////////////////////////////
+
+
+    // Share the tiles of the matrix among several threads
+    void OsiScoreMatrix::computeTiles ( const vector<OsiIrisCode> & rProbes ,
+                                        const vector<OsiIrisCode> & rGallery ,
+                                        int nThreads ,
+                                        int tileSize )
+    {
+        tileSize = max(tileSize,1) ;
+
+        // List the tiles, row after row. Symmetric matrix : upper triangle only
+        vector< pair<int,int> > tiles ;
+        for ( int r = 0 ; r < mRows ; r += tileSize )
+        {
+            for ( int c = ( mSymmetric ? r : 0 ) ; c < mCols ; c += tileSize )
+            {
+                tiles.push_back(make_pair(r,c)) ;
+            }
+        }
+
+        // Number of threads
+        if ( nThreads <= 0 )
+        {
+            nThreads = max((int)thread::hardware_concurrency(),1) ;
+        }
+        nThreads = min(nThreads,(int)tiles.size()) ;
+
+        // Each thread takes the next tile to be computed
+        atomic<int> next(0) ;
+        vector<thread> workers ;
+        for ( int t = 0 ; t < nThreads ; t++ )
+        {
+            workers.push_back(thread([&]()
+            {
+                for ( int i = next++ ; i < tiles.size() ; i = next++ )
+                {
+                    computeTile(rProbes,rGallery,tiles[i].first,tiles[i].second,tileSize) ;
+                }
+            })) ;
+        }
+        for ( int t = 0 ; t < workers.size() ; t++ )
+        {
+            workers[t].join() ;
+        }
+    }
+
+
+
+    // Compute the scores of one tile
+    void OsiScoreMatrix::computeTile ( const vector<OsiIrisCode> & rProbes ,
+                                       const vector<OsiIrisCode> & rGallery ,
+                                       int firstRow ,
+                                       int firstCol ,
+                                       int tileSize )
+    {
+        int last_row = min(firstRow+tileSize,mRows) ;
+        int last_col = min(firstCol+tileSize,mCols) ;
+
+        for ( int i = firstRow ; i < last_row ; i++ )
+        {
+            if ( rProbes[i].isEmpty() )
+            {
+                continue ;
+            }
+
+            // The shifted versions of the probe are built once for the whole row of the tile
+            OsiProbe probe(rProbes[i]) ;
+
+            // Symmetric matrix : upper triangle only
+            for ( int j = ( mSymmetric ? max(firstCol,i) : firstCol ) ; j < last_col ; j++ )
+            {
+                if ( ! rGallery[j].isEmpty() )
+                {
+                    mScores[(size_t)i*mCols+j] = probe.match(rGallery[j]) ;
+                }
+            }
+        }
+    }
+
+} // end of namespace
+
@@ -0,0 +1,142 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_SCORE_MATRIX_H
+#define OSI_SCORE_MATRIX_H
+
+#include <string>
+#include <vector>
+#include "OsiIrisCode.h"
+
+namespace osiris
+{
+
+    /** Matrix of matching scores (all-vs-all matching).
+    * Match every probe against every gallery template. The matrix is cut into
+    * tiles of templates small enough to stay in cache, and the tiles are shared
+    * among several threads.\n
+    * When probes and gallery are the same list, only the upper triangle is computed :
+    * the score of the pair (i,j), i<j, is OsiIrisCode::match() with i as first code,
+    * and is copied to (j,i).\n
+    * A missing template (empty code) gives the score -1.
+    * @see OsiIrisCode::match() , OsiManager
+    */
+    class OsiScoreMatrix
+    {
+
+    public :
+
+        /** Default constructor. Build an empty matrix. */
+        OsiScoreMatrix ( ) ;
+
+        /** Default destructor. */
+        ~OsiScoreMatrix ( ) ;
+
+        /** Match all probes against all gallery templates.
+        * @param rProbes The templates of the probes (rows of the matrix)
+        * @param rGallery The templates of the gallery (columns of the matrix)
+        * @param nThreads The number of threads, 0 for all available cores
+        * @param tileSize The number of templates per side of a tile
+        * @return void
+        */
+        void compute ( const std::vector<OsiIrisCode> & rProbes ,
+                       const std::vector<OsiIrisCode> & rGallery ,
+                       int nThreads = 0 ,
+                       int tileSize = 64 ) ;
+
+        /** Match all templates against each other (symmetric matrix).
+        * @param rCodes The templates
+        * @param nThreads The number of threads, 0 for all available cores
+        * @param tileSize The number of templates per side of a tile
+        * @return void
+        */
+        void compute ( const std::vector<OsiIrisCode> & rCodes ,
+                       int nThreads = 0 ,
+                       int tileSize = 64 ) ;
+
+        /** Get the number of rows (probes).
+        * @return The number of rows
+        */
+        int getNumberOfRows ( ) const ;
+
+        /** Get the number of columns (gallery templates).
+        * @return The number of columns
+        */
+        int getNumberOfCols ( ) const ;
+
+        /** Get one score.
+        * @param row The index of the probe
+        * @param col The index of the gallery template
+        * @return The matching score
+        */
+        float getScore ( int row , int col ) const ;
+
+        /** Save the matrix into a binary file.
+        * The file contains a header ("OSIM", version, rows, cols, symmetric flag as 32-bit integers)
+        * followed by the scores as 32-bit floats, row after row.
+        * Values are written with the byte order of the machine.
+        * @param rFilename Complete path of the file
+        * @return void
+        * @see load()
+        */
+        void save ( const std::string & rFilename ) const ;
+
+        /** Load the matrix from a binary file.
+        * @param rFilename Complete path of the file
+        * @return void
+        * @see save()
+        */
+        void load ( const std::string & rFilename ) ;
+
+    private :
+
+        /** Number of rows. */
+        int mRows ;
+
+        /** Number of columns. */
+        int mCols ;
+
+        /** Is the matrix symmetric. */
+        bool mSymmetric ;
+
+        /** The scores, row after row. */
+        std::vector<float> mScores ;
+
+        /** Compute the tiles of the matrix with several threads.
+        * @param rProbes The templates of the rows
+        * @param rGallery The templates of the columns
+        * @param nThreads The number of threads, 0 for all available cores
+        * @param tileSize The number of templates per side of a tile
+        * @return void
+        */
+        void computeTiles ( const std::vector<OsiIrisCode> & rProbes ,
+                            const std::vector<OsiIrisCode> & rGallery ,
+                            int nThreads ,
+                            int tileSize ) ;
+
+        /** Compute one tile.
+        * @param rProbes The templates of the rows
+        * @param rGallery The templates of the columns
+        * @param firstRow The first row of the tile
+        * @param firstCol The first column of the tile
+        * @param tileSize The number of templates per side of a tile
+        * @return void
+        */
+        void computeTile ( const std::vector<OsiIrisCode> & rProbes ,
+                           const std::vector<OsiIrisCode> & rGallery ,
+                           int firstRow ,
+                           int firstCol ,
+                           int tileSize ) ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
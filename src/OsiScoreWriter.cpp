@@ -0,0 +1,242 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+#include "OsiScoreWriter.h"
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // Maximum number of full blocks waiting for the disk
+    static const int MAX_PENDING_BLOCKS = 4 ;
+
+
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiScoreWriter::OsiScoreWriter ( )
+    {
+        mBlockSize = 0 ;
+        mClosing = false ;
+        mFailed = false ;
+    }
+
+    OsiScoreWriter::~OsiScoreWriter ( )
+    {
+        try
+        {
+            close() ;
+        }
+        catch ( exception & )
+        {
+            // An error cannot be reported from the destructor
+        }
+    }
+
+
+
+
+
+    // OPERATORS
+    ////////////
+
+    void OsiScoreWriter::open ( const string & rFilename , int blockSize )
+    {
+        close() ;
+
+        mFile.open(rFilename.c_str(),ios::out|ios::binary) ;
+        if ( ! mFile )
+        {
+            throw runtime_error("Cannot create the file for matching scores : " + rFilename) ;
+        }
+
+        // Header : version, size of a record
+        int32_t header[2] = { 1 , sizeof(OsiScoreRecord) } ;
+        mFile.write("OSIS",4) ;
+        mFile.write((const char*)header,sizeof(header)) ;
+
+        mFilename = rFilename ;
+        mBlockSize = max(blockSize,1) ;
+        mBlock.reserve(mBlockSize) ;
+        mClosing = false ;
+        mFailed = false ;
+        mWriter = thread(&OsiScoreWriter::writeBlocks,this) ;
+    }
+
+
+
+    void OsiScoreWriter::write ( int index1 , int index2 , float score , int shift )
+    {
+        OsiScoreRecord record = { index1 , index2 , score , shift } ;
+        mBlock.push_back(record) ;
+        if ( mBlock.size() >= mBlockSize )
+        {
+            pushBlock() ;
+        }
+    }
+
+
+
+    void OsiScoreWriter::close ( )
+    {
+        if ( ! mWriter.joinable() )
+        {
+            return ;
+        }
+
+        // Last block, then wait for the background thread
+        if ( ! mBlock.empty() )
+        {
+            pushBlock() ;
+        }
+        {
+            lock_guard<mutex> lock(mMutex) ;
+            mClosing = true ;
+        }
+        mCondition.notify_all() ;
+        mWriter.join() ;
+
+        mFile.close() ;
+        mBlock.clear() ;
+        if ( mFailed || mFile.fail() )
+        {
+            throw runtime_error("Error while saving matching scores in " + mFilename) ;
+        }
+    }
+
+
+
+    bool OsiScoreWriter::isOpened ( ) const
+    {
+        return mWriter.joinable() ;
+    }
+
+
+
+    void OsiScoreWriter::convert ( const string & rBinaryFilename ,
+                                   const vector<string> & rListOfImages ,
+                                   const string & rTextFilename )
+    {
+        ifstream input(rBinaryFilename.c_str(),ios::in|ios::binary) ;
+        if ( ! input )
+        {
+            throw runtime_error("Cannot load the matching scores in " + rBinaryFilename) ;
+        }
+
+        // Header
+        char magic[4] ;
+        int32_t header[2] ;
+        input.read(magic,4) ;
+        input.read((char*)header,sizeof(header)) ;
+        if ( ! input || string(magic,4) != "OSIS" || header[0] != 1 || header[1] != sizeof(OsiScoreRecord) )
+        {
+            throw runtime_error("Invalid file of matching scores : " + rBinaryFilename) ;
+        }
+
+        ofstream output(rTextFilename.c_str(),ios::out) ;
+        if ( ! output )
+        {
+            throw runtime_error("Cannot create the file for matching scores : " + rTextFilename) ;
+        }
+
+        // Records, block by block
+        vector<OsiScoreRecord> records(4096) ;
+        int n_images = rListOfImages.size() ;
+        while ( input )
+        {
+            input.read((char*)&records[0],records.size()*sizeof(OsiScoreRecord)) ;
+            int n_records = input.gcount() / sizeof(OsiScoreRecord) ;
+            if ( ! input && input.gcount() % sizeof(OsiScoreRecord) )
+            {
+                throw runtime_error("Truncated file of matching scores : " + rBinaryFilename) ;
+            }
+            for ( int r = 0 ; r < n_records ; r++ )
+            {
+                const OsiScoreRecord & record = records[r] ;
+                if ( record.mIndex1 < 0 || record.mIndex1 >= n_images || record.mIndex2 < 0 || record.mIndex2 >= n_images )
+                {
+                    throw runtime_error("The matching scores of " + rBinaryFilename + " do not match the list of images") ;
+                }
+                output << rListOfImages[record.mIndex1] << " " ;
+                output << rListOfImages[record.mIndex2] << " " ;
+                output << record.mScore << "\n" ;
+            }
+        }
+
+        output.close() ;
+        if ( ! output )
+        {
+            throw runtime_error("Error while saving matching scores in " + rTextFilename) ;
+        }
+    }
+
+
+
+
+
+    ///////////////////////////////////
+    // PRIVATE METHODS
+    ///////////////////////////////////
+
+
+    // Give the current block to the background thread, wait if too many blocks are pending
+    void OsiScoreWriter::pushBlock ( )
+    {
+        vector<OsiScoreRecord> block ;
+        block.reserve(mBlockSize) ;
+        block.swap(mBlock) ;
+
+        unique_lock<mutex> lock(mMutex) ;
+        mCondition.wait(lock,[this]() { return mPendingBlocks.size() < MAX_PENDING_BLOCKS || mFailed ; }) ;
+        mPendingBlocks.push_back(vector<OsiScoreRecord>()) ;
+        mPendingBlocks.back().swap(block) ;
+        lock.unlock() ;
+        mCondition.notify_all() ;
+    }
+
+
+
+    // Background thread : write the blocks in order
+    void OsiScoreWriter::writeBlocks ( )
+    {
+        unique_lock<mutex> lock(mMutex) ;
+        while ( true )
+        {
+            mCondition.wait(lock,[this]() { return ! mPendingBlocks.empty() || mClosing ; }) ;
+            if ( mPendingBlocks.empty() )
+            {
+                return ;
+            }
+
+            // The disk is accessed without the lock
+            vector<OsiScoreRecord> block ;
+            block.swap(mPendingBlocks.front()) ;
+            mPendingBlocks.pop_front() ;
+            lock.unlock() ;
+            mCondition.notify_all() ;
+
+            if ( ! mFailed )
+            {
+                mFile.write((const char*)&block[0],block.size()*sizeof(OsiScoreRecord)) ;
+            }
+
+            lock.lock() ;
+            if ( ! mFile )
+            {
+                mFailed = true ;
+                mCondition.notify_all() ;
+            }
+        }
+    }
+
+} // end of namespace
+
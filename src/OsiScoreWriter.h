@@ -0,0 +1,151 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_SCORE_WRITER_H
+#define OSI_SCORE_WRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+namespace osiris
+{
+
+    /** One matching result of a binary score file. */
+    struct OsiScoreRecord
+    {
+        /** Index of the first image in the list of images. */
+        int32_t mIndex1 ;
+
+        /** Index of the second image in the list of images. */
+        int32_t mIndex2 ;
+
+        /** Matching score. */
+        float mScore ;
+
+        /** Shift in columns of the first code giving the score. */
+        int32_t mShift ;
+    } ;
+
+
+
+    /** Writer of binary matching scores.
+    * The file contains a header ("OSIS", then version and size of a record as 32-bit integers)
+    * followed by the records (OsiScoreRecord, 16 bytes each), with the byte order of the machine.\n
+    * The records are gathered into blocks, and the blocks are written to the file by a
+    * background thread : the matching loop does not wait for the disk, and the file is never
+    * flushed for a single score. If the disk is slower than the matching, write() waits
+    * when a few blocks are pending.
+    * @see convert() , OsiManager
+    */
+    class OsiScoreWriter
+    {
+
+    public :
+
+        /** Default constructor. */
+        OsiScoreWriter ( ) ;
+
+        /** Default destructor. Write the pending scores and close the file. */
+        ~OsiScoreWriter ( ) ;
+
+        /** Create a file and start the background thread.
+        * @param rFilename Complete path of the file
+        * @param blockSize The number of records of a block
+        * @return void
+        */
+        void open ( const std::string & rFilename , int blockSize = 4096 ) ;
+
+        /** Add a matching result.
+        * @param index1 The index of the first image in the list of images
+        * @param index2 The index of the second image in the list of images
+        * @param score The matching score
+        * @param shift The shift giving the score
+        * @return void
+        */
+        void write ( int index1 , int index2 , float score , int shift ) ;
+
+        /** Write the pending scores, stop the background thread and close the file.
+        * @return void
+        */
+        void close ( ) ;
+
+        /** Check if a file is opened.
+        * @return true if a file is opened
+        */
+        bool isOpened ( ) const ;
+
+        /** Convert a binary score file into the text format of the matching
+        * (one line per pair : name of the first image, name of the second image, score).
+        * @param rBinaryFilename Complete path of the binary file
+        * @param rListOfImages The list of images used for the matching
+        * @param rTextFilename Complete path of the text file
+        * @return void
+        */
+        static void convert ( const std::string & rBinaryFilename ,
+                              const std::vector<std::string> & rListOfImages ,
+                              const std::string & rTextFilename ) ;
+
+    private :
+
+        /** The file. */
+        std::ofstream mFile ;
+
+        /** Complete path of the file. */
+        std::string mFilename ;
+
+        /** Number of records of a block. */
+        int mBlockSize ;
+
+        /** The block being filled. */
+        std::vector<OsiScoreRecord> mBlock ;
+
+        /** The full blocks waiting to be written. */
+        std::deque< std::vector<OsiScoreRecord> > mPendingBlocks ;
+
+        /** Protection of the pending blocks and flags. */
+        std::mutex mMutex ;
+
+        /** Signal of a new pending block, a written block, or the end. */
+        std::condition_variable mCondition ;
+
+        /** The background thread. */
+        std::thread mWriter ;
+
+        /** Is the file closing. */
+        bool mClosing ;
+
+        /** Did an error occur while writing. */
+        bool mFailed ;
+
+        /** Give the current block to the background thread.
+        * @return void
+        */
+        void pushBlock ( ) ;
+
+        /** Write the pending blocks until the file is closed (background thread).
+        * @return void
+        */
+        void writeBlocks ( ) ;
+
+        /** A writer cannot be copied. */
+        OsiScoreWriter ( const OsiScoreWriter & ) ;
+        OsiScoreWriter & operator = ( const OsiScoreWriter & ) ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
@@ -0,0 +1,167 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include "cv.h"
+#include "OsiSeparableFilters.h"
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiSeparableFilters::OsiSeparableFilters ( )
+    {
+        // Do nothing
+    }
+
+    OsiSeparableFilters::~OsiSeparableFilters ( )
+    {
+        clear() ;
+    }
+
+
+
+
+
+    // OPERATORS
+    ////////////
+
+    void OsiSeparableFilters::create ( const vector<CvMat*> & rFilters , int rank )
+    {
+        clear() ;
+        mColumnKernels.resize(rFilters.size()) ;
+        mRowKernels.resize(rFilters.size()) ;
+        mErrors.resize(rFilters.size()) ;
+        mTolerances.resize(rFilters.size()) ;
+
+        for ( int f = 0 ; f < rFilters.size() ; f++ )
+        {
+            // Kernel = U * diag(W) * V', singular values in decreasing order
+            int rows = rFilters[f]->rows ;
+            int cols = rFilters[f]->cols ;
+            int n = min(rows,cols) ;
+            CvMat * a = cvCreateMat(rows,cols,CV_64FC1) ;
+            CvMat * w = cvCreateMat(n,1,CV_64FC1) ;
+            CvMat * u = cvCreateMat(rows,n,CV_64FC1) ;
+            CvMat * v = cvCreateMat(cols,n,CV_64FC1) ;
+            cvConvert(rFilters[f],a) ;
+            double l1 = 0 ;
+            for ( int i = 0 ; i < rows ; i++ )
+                for ( int j = 0 ; j < cols ; j++ )
+                    l1 += fabs(cvmGet(a,i,j)) ;
+            mTolerances[f] = 1e-6 * 255 * l1 ;
+            cvSVD(a,w,u,v,0) ;
+
+            // Keep the largest terms, the singular value goes into the column kernel
+            double total = 0 , kept = 0 ;
+            for ( int k = 0 ; k < n ; k++ )
+            {
+                double sigma = cvmGet(w,k,0) ;
+                total += sigma * sigma ;
+                if ( k >= rank || sigma <= 0 )
+                {
+                    continue ;
+                }
+                kept += sigma * sigma ;
+
+                CvMat * column = cvCreateMat(rows,1,CV_32FC1) ;
+                CvMat * row = cvCreateMat(1,cols,CV_32FC1) ;
+                for ( int i = 0 ; i < rows ; i++ )
+                {
+                    cvmSet(column,i,0,sigma*cvmGet(u,i,k)) ;
+                }
+                for ( int j = 0 ; j < cols ; j++ )
+                {
+                    cvmSet(row,0,j,cvmGet(v,j,k)) ;
+                }
+                mColumnKernels[f].push_back(column) ;
+                mRowKernels[f].push_back(row) ;
+            }
+            mErrors[f] = ( total > 0 ) ? sqrt(max(total-kept,0.0)/total) : 0 ;
+
+            cvReleaseMat(&a) ;
+            cvReleaseMat(&w) ;
+            cvReleaseMat(&u) ;
+            cvReleaseMat(&v) ;
+        }
+    }
+
+
+
+    void OsiSeparableFilters::clear ( )
+    {
+        for ( int f = 0 ; f < mColumnKernels.size() ; f++ )
+        {
+            for ( int k = 0 ; k < mColumnKernels[f].size() ; k++ )
+            {
+                cvReleaseMat(&mColumnKernels[f][k]) ;
+                cvReleaseMat(&mRowKernels[f][k]) ;
+            }
+        }
+        mColumnKernels.clear() ;
+        mRowKernels.clear() ;
+        mErrors.clear() ;
+        mTolerances.clear() ;
+    }
+
+
+
+    bool OsiSeparableFilters::isEmpty ( ) const
+    {
+        return mErrors.empty() ;
+    }
+
+
+
+    int OsiSeparableFilters::getNumberOfFilters ( ) const
+    {
+        return mErrors.size() ;
+    }
+
+
+
+    int OsiSeparableFilters::getNumberOfTerms ( int filter ) const
+    {
+        return mColumnKernels[filter].size() ;
+    }
+
+
+
+    const CvMat * OsiSeparableFilters::getColumnKernel ( int filter , int term ) const
+    {
+        return mColumnKernels[filter][term] ;
+    }
+
+
+
+    const CvMat * OsiSeparableFilters::getRowKernel ( int filter , int term ) const
+    {
+        return mRowKernels[filter][term] ;
+    }
+
+
+
+    float OsiSeparableFilters::getError ( int filter ) const
+    {
+        return mErrors[filter] ;
+    }
+
+
+
+    float OsiSeparableFilters::getTolerance ( int filter ) const
+    {
+        return mTolerances[filter] ;
+    }
+
+} // end of namespace
+
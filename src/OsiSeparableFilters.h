@@ -0,0 +1,121 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_SEPARABLE_FILTERS_H
+#define OSI_SEPARABLE_FILTERS_H
+
+#include <vector>
+#include "highgui.h"
+
+namespace osiris
+{
+
+    /** Low-rank separable approximation of a bank of filters.
+    * Each kernel is decomposed by SVD into a sum of separable terms (a column kernel
+    * times a row kernel), and only the terms of the largest singular values are kept.
+    * A term costs rows + cols multiplications per pixel instead of rows x cols for the
+    * dense kernel : 60 instead of 459 for a 9x51 kernel.\n
+    * The approximation error of a kernel is the relative Frobenius norm of the dropped terms,
+    * sqrt(sum of the dropped squared singular values / sum of all squared singular values).\n
+    * Two passes do not round like the dense convolution : where the dense response is exactly 0
+    * (flat areas), the separable one is a small residue of either sign. Such responses are
+    * thresholded with a tolerance, see getTolerance().
+    * @see OsiProcessings::encode()
+    */
+    class OsiSeparableFilters
+    {
+
+    public :
+
+        /** Default constructor. Build an empty bank. */
+        OsiSeparableFilters ( ) ;
+
+        /** Default destructor. Release the kernels. */
+        ~OsiSeparableFilters ( ) ;
+
+        /** Decompose a bank of filters.
+        * @param rFilters The bank of Gabor filters
+        * @param rank The maximum number of separable terms for each filter
+        * @return void
+        */
+        void create ( const std::vector<CvMat*> & rFilters , int rank ) ;
+
+        /** Release the kernels.
+        * @return void
+        */
+        void clear ( ) ;
+
+        /** Check if the bank is built.
+        * @return true if there is no filter
+        */
+        bool isEmpty ( ) const ;
+
+        /** Get the number of filters.
+        * @return The number of filters of the bank
+        */
+        int getNumberOfFilters ( ) const ;
+
+        /** Get the number of separable terms of a filter.
+        * @param filter The index of the filter
+        * @return The number of terms, not more than the rank (the null terms are dropped)
+        */
+        int getNumberOfTerms ( int filter ) const ;
+
+        /** Get the column kernel of a term, weighted by the singular value.
+        * @param filter The index of the filter
+        * @param term The index of the term
+        * @return A matrix of rows x 1
+        */
+        const CvMat * getColumnKernel ( int filter , int term ) const ;
+
+        /** Get the row kernel of a term.
+        * @param filter The index of the filter
+        * @param term The index of the term
+        * @return A matrix of 1 x cols
+        */
+        const CvMat * getRowKernel ( int filter , int term ) const ;
+
+        /** Get the approximation error of a filter.
+        * @param filter The index of the filter
+        * @return The relative error, 0 if the kernel is exactly represented
+        */
+        float getError ( int filter ) const ;
+
+        /** Get the threshold of the responses of a filter, below which they are taken as 0.
+        * It covers the rounding of both passes for an 8-bit image, far below the response of one
+        * grey level : 1e-6 x 255 x (sum of absolute coefficients of the kernel).
+        * @param filter The index of the filter
+        * @return The tolerance, to be used as threshold of the sign
+        */
+        float getTolerance ( int filter ) const ;
+
+    private :
+
+        /** The column kernels of each filter. */
+        std::vector< std::vector<CvMat*> > mColumnKernels ;
+
+        /** The row kernels of each filter. */
+        std::vector< std::vector<CvMat*> > mRowKernels ;
+
+        /** The approximation errors. */
+        std::vector<float> mErrors ;
+
+        /** The tolerances of rounding. */
+        std::vector<float> mTolerances ;
+
+        /** Filters cannot be copied. */
+        OsiSeparableFilters ( const OsiSeparableFilters & ) ;
+        OsiSeparableFilters & operator = ( const OsiSeparableFilters & ) ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
@@ -0,0 +1,240 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include <cstring>
+#include <stdexcept>
+#include "OsiServer.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiServer::OsiServer ( )
+    {
+        mSocket = -1 ;
+        mRunning = false ;
+    }
+
+    OsiServer::~OsiServer ( )
+    {
+        close() ;
+    }
+
+
+
+
+
+    // OPERATORS
+    ////////////
+
+#ifndef _WIN32
+
+    void OsiServer::open ( const string & rPath )
+    {
+        close() ;
+
+        sockaddr_un address ;
+        memset(&address,0,sizeof(address)) ;
+        address.sun_family = AF_UNIX ;
+        if ( rPath.empty() || rPath.size() >= sizeof(address.sun_path) )
+        {
+            throw runtime_error("Invalid path for the server socket : " + rPath) ;
+        }
+        strncpy(address.sun_path,rPath.c_str(),sizeof(address.sun_path)-1) ;
+
+        // A client closing its connection must not kill the server
+        signal(SIGPIPE,SIG_IGN) ;
+
+        mSocket = socket(AF_UNIX,SOCK_STREAM,0) ;
+        if ( mSocket < 0 )
+        {
+            throw runtime_error("Cannot create the server socket : " + string(strerror(errno))) ;
+        }
+
+        // Replace the socket left by a previous server, but never another file
+        struct stat status ;
+        if ( lstat(rPath.c_str(),&status) == 0 )
+        {
+            if ( ! S_ISSOCK(status.st_mode) )
+            {
+                ::close(mSocket) ;
+                mSocket = -1 ;
+                throw runtime_error("Cannot create the server socket because " + rPath + " is not a socket") ;
+            }
+            unlink(rPath.c_str()) ;
+        }
+        if ( bind(mSocket,(sockaddr*)&address,sizeof(address)) < 0 || listen(mSocket,16) < 0 )
+        {
+            string error = strerror(errno) ;
+            ::close(mSocket) ;
+            mSocket = -1 ;
+            throw runtime_error("Cannot listen to the server socket " + rPath + " : " + error) ;
+        }
+
+        mPath = rPath ;
+    }
+
+
+
+    void OsiServer::close ( )
+    {
+        if ( mSocket >= 0 )
+        {
+            ::close(mSocket) ;
+            unlink(mPath.c_str()) ;
+            mSocket = -1 ;
+        }
+    }
+
+
+
+    void OsiServer::run ( const Handler & rHandler )
+    {
+        if ( mSocket < 0 )
+        {
+            throw runtime_error("Cannot run the server because its socket is not opened") ;
+        }
+
+        mRunning = true ;
+        while ( mRunning )
+        {
+            int client = accept(mSocket,0,0) ;
+            if ( client < 0 )
+            {
+                if ( errno == EINTR )
+                {
+                    continue ;
+                }
+                throw runtime_error("Cannot accept a client on the server socket : " + string(strerror(errno))) ;
+            }
+
+            serveClient(client,rHandler) ;
+            ::close(client) ;
+        }
+    }
+
+#else
+
+    void OsiServer::open ( const string & rPath )
+    {
+        throw runtime_error("The server is not available on this system") ;
+    }
+
+
+
+    void OsiServer::close ( )
+    {
+        // Do nothing
+    }
+
+
+
+    void OsiServer::run ( const Handler & rHandler )
+    {
+        throw runtime_error("The server is not available on this system") ;
+    }
+
+#endif
+
+
+
+    void OsiServer::stop ( )
+    {
+        mRunning = false ;
+    }
+
+
+
+
+
+    ///////////////////////////////////
+    // PRIVATE METHODS
+    ///////////////////////////////////
+
+
+#ifndef _WIN32
+
+    // Read the requests of a client line by line, and send the answers
+    void OsiServer::serveClient ( int client , const Handler & rHandler )
+    {
+        string buffer ;
+        char data[4096] ;
+
+        while ( mRunning )
+        {
+            // Answer all complete lines
+            size_t end ;
+            while ( mRunning && ( end = buffer.find('\n') ) != string::npos )
+            {
+                string request = buffer.substr(0,end) ;
+                buffer.erase(0,end+1) ;
+                if ( ! request.empty() && request[request.size()-1] == '\r' )
+                {
+                    request.erase(request.size()-1) ;
+                }
+
+                string answer = rHandler(request) + "\n" ;
+                for ( size_t sent = 0 ; sent < answer.size() ; )
+                {
+                    ssize_t n = send(client,answer.data()+sent,answer.size()-sent,0) ;
+                    if ( n < 0 && errno == EINTR )
+                    {
+                        continue ;
+                    }
+                    if ( n <= 0 )
+                    {
+                        return ;
+                    }
+                    sent += n ;
+                }
+            }
+
+            // A line without end would fill the memory
+            if ( buffer.size() > OSI_MAX_REQUEST_SIZE )
+            {
+                return ;
+            }
+
+            // Wait for more data, stop when the client disconnects
+            ssize_t n = recv(client,data,sizeof(data),0) ;
+            if ( n < 0 && errno == EINTR )
+            {
+                continue ;
+            }
+            if ( n <= 0 )
+            {
+                return ;
+            }
+            buffer.append(data,n) ;
+        }
+    }
+
+#else
+
+    void OsiServer::serveClient ( int client , const Handler & rHandler )
+    {
+        // Do nothing
+    }
+
+#endif
+
+} // end of namespace
+
@@ -0,0 +1,91 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_SERVER_H
+#define OSI_SERVER_H
+
+#include <functional>
+#include <string>
+
+// Maximum size in bytes of a request line, a client sending a longer line is disconnected
+#define OSI_MAX_REQUEST_SIZE 65536
+
+namespace osiris
+{
+
+    /** Local server over a Unix domain socket.
+    * Requests and answers are lines of text : each line received from a client is
+    * given to a handler, and the line returned by the handler is sent back.
+    * Clients are served one after the other, so the handler is never called concurrently.\n
+    * Only available on POSIX systems : open() throws an exception on Windows.
+    * @see OsiManager
+    */
+    class OsiServer
+    {
+
+    public :
+
+        /** Handler of one request : get the request line, return the answer line. */
+        typedef std::function<std::string(const std::string &)> Handler ;
+
+        /** Default constructor. */
+        OsiServer ( ) ;
+
+        /** Default destructor. Close the socket. */
+        ~OsiServer ( ) ;
+
+        /** Create the socket and listen to it.
+        * A socket left at the same path by a previous server is replaced, any other file is kept
+        * and an exception is thrown.
+        * @param rPath The path of the socket
+        * @return void
+        */
+        void open ( const std::string & rPath ) ;
+
+        /** Close the socket and remove its file.
+        * @return void
+        */
+        void close ( ) ;
+
+        /** Serve the clients until stop() is called.
+        * @param rHandler The handler of the requests
+        * @return void
+        */
+        void run ( const Handler & rHandler ) ;
+
+        /** Stop the server after the current request.
+        * @return void
+        */
+        void stop ( ) ;
+
+    private :
+
+        /** The path of the socket. */
+        std::string mPath ;
+
+        /** The listening socket, -1 if closed. */
+        int mSocket ;
+
+        /** Is the server running. */
+        bool mRunning ;
+
+        /** Serve one client until it disconnects or the server is stopped.
+        * A client sending a line longer than OSI_MAX_REQUEST_SIZE is disconnected.
+        * @param client The socket of the client
+        * @param rHandler The handler of the requests
+        * @return void
+        */
+        void serveClient ( int client , const Handler & rHandler ) ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+
@@ -0,0 +1,142 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#include "OsiTemplateCache.h"
+
+using namespace std ;
+
+namespace osiris
+{
+
+    // CONSTRUCTORS & DESTRUCTORS
+    /////////////////////////////
+
+    OsiTemplateCache::OsiTemplateCache ( size_t capacity )
+    {
+        mCapacity = capacity ;
+        mSize = 0 ;
+        mHits = 0 ;
+        mMisses = 0 ;
+    }
+
+    OsiTemplateCache::~OsiTemplateCache ( )
+    {
+        // Do nothing
+    }
+
+
+
+
+
+    // OPERATORS
+    ////////////
+
+    void OsiTemplateCache::setCapacity ( size_t capacity )
+    {
+        mCapacity = capacity ;
+        evict(mCapacity) ;
+    }
+
+
+
+    bool OsiTemplateCache::find ( const string & rName , OsiIrisCode & rCode )
+    {
+        map< string , list< pair<string,OsiIrisCode> >::iterator >::iterator it = mPositions.find(rName) ;
+        if ( it == mPositions.end() )
+        {
+            mMisses++ ;
+            return false ;
+        }
+
+        // Move to the front of the list
+        mEntries.splice(mEntries.begin(),mEntries,it->second) ;
+        rCode = it->second->second ;
+        mHits++ ;
+
+        return true ;
+    }
+
+
+
+    void OsiTemplateCache::insert ( const string & rName , const OsiIrisCode & rCode )
+    {
+        // Replace an existing entry
+        map< string , list< pair<string,OsiIrisCode> >::iterator >::iterator it = mPositions.find(rName) ;
+        if ( it != mPositions.end() )
+        {
+            mSize -= it->second->second.getSizeInBytes() ;
+            mEntries.erase(it->second) ;
+            mPositions.erase(it) ;
+        }
+
+        // Do not keep a template that cannot fit in the budget
+        size_t size = rCode.getSizeInBytes() ;
+        if ( size > mCapacity )
+        {
+            return ;
+        }
+
+        // Make room, then add as the most recently used
+        evict(mCapacity-size) ;
+        mEntries.push_front(make_pair(rName,rCode)) ;
+        mPositions[rName] = mEntries.begin() ;
+        mSize += size ;
+    }
+
+
+
+    void OsiTemplateCache::clear ( )
+    {
+        mEntries.clear() ;
+        mPositions.clear() ;
+        mSize = 0 ;
+    }
+
+
+
+    size_t OsiTemplateCache::getSize ( ) const
+    {
+        return mSize ;
+    }
+
+
+
+    int OsiTemplateCache::getNumberOfHits ( ) const
+    {
+        return mHits ;
+    }
+
+
+
+    int OsiTemplateCache::getNumberOfMisses ( ) const
+    {
+        return mMisses ;
+    }
+
+
+
+
+
+    ///////////////////////////////////
+    // PRIVATE METHODS
+    ///////////////////////////////////
+
+
+    // Remove the least recently used templates
+    void OsiTemplateCache::evict ( size_t capacity )
+    {
+        while ( mSize > capacity && ! mEntries.empty() )
+        {
+            mSize -= mEntries.back().second.getSizeInBytes() ;
+            mPositions.erase(mEntries.back().first) ;
+            mEntries.pop_back() ;
+        }
+    }
+
+} // end of namespace
+
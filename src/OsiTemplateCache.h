@@ -0,0 +1,111 @@
+/*******************************************************
+* Open Source for Iris : OSIRIS
+* Version : 4.0
+* Date : 2011
+* Author : Guillaume Sutra, Telecom SudParis, France
+* License : BSD
+********************************************************/
+
+#ifndef OSI_TEMPLATE_CACHE_H
+#define OSI_TEMPLATE_CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <string>
+#include "OsiIrisCode.h"
+
+namespace osiris
+{
+
+    /** Cache of templates.
+    * Keep the templates of the last used eyes in memory, so that an eye appearing
+    * in several pairs of a matching list is processed (or loaded) only once.
+    * When the memory budget is exceeded, the least recently used templates are evicted.
+    * @see OsiIrisCode , OsiManager
+    */
+    class OsiTemplateCache
+    {
+
+    public :
+
+        /** Default constructor.
+        * @param capacity The memory budget in bytes
+        */
+        OsiTemplateCache ( size_t capacity = 0 ) ;
+
+        /** Default destructor. */
+        ~OsiTemplateCache ( ) ;
+
+        /** Set the memory budget, evict templates if needed.
+        * @param capacity The memory budget in bytes
+        * @return void
+        */
+        void setCapacity ( size_t capacity ) ;
+
+        /** Look for a template, it becomes the most recently used one.
+        * @param rName The eye name
+        * @param rCode The template. Filled by the function if the eye is in the cache
+        * @return true if the eye is in the cache
+        */
+        bool find ( const std::string & rName , OsiIrisCode & rCode ) ;
+
+        /** Add a template, evict the least recently used ones if memory budget is exceeded.
+        * A template bigger than the memory budget is not kept.
+        * @param rName The eye name
+        * @param rCode The template
+        * @return void
+        */
+        void insert ( const std::string & rName , const OsiIrisCode & rCode ) ;
+
+        /** Remove all templates.
+        * @return void
+        */
+        void clear ( ) ;
+
+        /** Get the memory used by the templates.
+        * @return The size in bytes
+        */
+        size_t getSize ( ) const ;
+
+        /** Get the number of successful calls to find().
+        * @return The number of hits
+        */
+        int getNumberOfHits ( ) const ;
+
+        /** Get the number of unsuccessful calls to find().
+        * @return The number of misses
+        */
+        int getNumberOfMisses ( ) const ;
+
+    private :
+
+        /** Templates, the most recently used first. */
+        std::list< std::pair<std::string,OsiIrisCode> > mEntries ;
+
+        /** Position of each eye in the list. */
+        std::map< std::string , std::list< std::pair<std::string,OsiIrisCode> >::iterator > mPositions ;
+
+        /** Memory budget in bytes. */
+        size_t mCapacity ;
+
+        /** Memory used in bytes. */
+        size_t mSize ;
+
+        /** Statistics. */
+        int mHits ;
+        int mMisses ;
+
+        /** Evict the least recently used templates until the memory used fits in the budget.
+        * @param capacity The memory budget in bytes
+        * @return void
+        */
+        void evict ( size_t capacity ) ;
+
+    } ; // End of class
+
+} // End of namespace
+
+
+#endif
+